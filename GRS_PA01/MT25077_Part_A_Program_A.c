@@ -9,7 +9,7 @@
  * worker functions (CPU-intensive, Memory-intensive, or I/O-intensive)
  * in each child process.
  *
- * Usage: ./program_a <cpu|mem|io> [num_processes]
+ * Usage: ./program_a <cpu|cpu-simd|mem|io> [num_processes]
  *        - First argument specifies worker type: cpu, mem, or io
  *        - Second argument (optional) specifies number of child processes (default: 2)
  *
@@ -17,14 +17,21 @@
  * For Part D: ./program_a <worker_type> <N>    (creates N child processes)
  */
 
+#define _GNU_SOURCE  /* for wait4 with -std=c11 */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <signal.h>
+#include <poll.h>
 #include <errno.h>
 #include "MT25077_Part_B_workers.h"
+#include "MT25077_Part_C_perf.h"
+#include "MT25077_Part_D_measure.h"
+#include "MT25077_Part_D_results.h"
 
 /* Default number of child processes for Part C */
 #define DEFAULT_NUM_PROCESSES 2
@@ -32,18 +39,164 @@
 /* Function pointer type for worker functions */
 typedef void (*worker_func_t)(void);
 
+/* Function pointer type for chunked workers used by the process pool */
+typedef void (*worker_chunk_func_t)(long start, long count);
+
+/* Mixed duty-cycle configuration (worker type "mix"), set before fork()
+ * so every child inherits it */
+static worker_mix_t g_worker_mix;
+
+static void worker_mix_entry(void) {
+    worker_mix_run(&g_worker_mix);
+}
+
+/*
+ * Hierarchical fork tree (--tree <fanout>)
+ *
+ * Forking thousands of workers sequentially from one parent makes the
+ * parent itself the bottleneck, and reaping them with N ordered waitpid()
+ * calls scales just as badly. In tree mode each intermediate node forks up
+ * to 'fanout' children, splitting its worker range among them; a node
+ * whose range is a single worker becomes that worker. Every node reaps
+ * with waitpid(-1) as children exit rather than in PID order, and failure
+ * counts propagate up through exit status. The root participates in the
+ * start barrier as an extra member, so the time from the first fork to
+ * barrier release is the full spawn latency, reported as processes/sec.
+ */
+static int tree_fanout;
+static worker_func_t tree_worker_func;
+static const pin_policy_t *tree_pin_policy;
+static const char *tree_numa_mode;
+static int tree_total_workers;
+
+/* Reap every child with waitpid(-1); returns number of failed subtrees */
+static int tree_reap_children(void) {
+    int failures = 0;
+    for (;;) {
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  /* ECHILD: everyone reaped */
+        }
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+/*
+ * Run the subtree covering workers [start, start + count). Forks up to
+ * tree_fanout children and reaps them; a count of 1 makes this process
+ * the worker itself. Returns the number of failures in the subtree.
+ */
+static int tree_spawn_range(int start, int count) {
+    if (count == 1) {
+        /* Leaf: this process is worker 'start' */
+        if (tree_pin_policy->mode != PIN_MODE_NONE) {
+            pin_policy_apply(tree_pin_policy, start, tree_total_workers);
+        }
+        if (tree_numa_mode != NULL) {
+            numa_policy_apply(tree_numa_mode);
+        }
+
+        start_barrier_wait();
+        tree_worker_func();
+        return 0;
+    }
+
+    /* Intermediate: split the range over up to tree_fanout children */
+    int branches = count < tree_fanout ? count : tree_fanout;
+    int offset = 0;
+    for (int b = 0; b < branches; b++) {
+        /* Distribute the remainder one worker at a time */
+        int share = count / branches + (b < count % branches ? 1 : 0);
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "Error: fork() failed in tree node: %s\n",
+                    strerror(errno));
+            /* The barrier can never release with leaves missing, which
+             * would park the whole tree forever: kill the process group
+             * (the root made itself its leader) to abort the run */
+            kill(0, SIGKILL);
+            exit(EXIT_FAILURE);
+        } else if (pid == 0) {
+            exit(tree_spawn_range(start + offset, share) > 0
+                     ? EXIT_FAILURE : EXIT_SUCCESS);
+        }
+        offset += share;
+    }
+
+    return tree_reap_children();
+}
+
+/*
+ * Process-pool job dispatch (worker type "pool")
+ *
+ * Forking a fresh set of children for every Part D cell pays full
+ * fork+COW+exit cost thousands of times per sweep. Pool mode forks N
+ * long-lived children once; the parent then reads jobs - lines of
+ * "<worker> <iterations>" - from stdin and dispatches them over per-child
+ * pipes as fixed-size records. Children run the matching chunked worker
+ * and report a completion record back over a result pipe; the parent
+ * multiplexes result pipes with poll() so any idle child can take the
+ * next job. Closing stdin drains the queue and shuts the pool down.
+ */
+
+/* Fixed-size job record sent parent -> child */
+typedef struct {
+    long job_id;
+    long iterations;
+    char worker[16];          /* worker type name, NUL-terminated */
+} pool_job_t;
+
+/* Fixed-size completion record sent child -> parent */
+typedef struct {
+    long      job_id;
+    long      iterations;
+    long long duration_ns;    /* CLOCK_MONOTONIC_RAW compute time */
+    char      worker[16];
+} pool_result_t;
+
 /*
  * Print usage information and exit
  */
 void print_usage(const char *program_name) {
-    fprintf(stderr, "Usage: %s <cpu|mem|io> [num_processes]\n", program_name);
+    fprintf(stderr, "Usage: %s <cpu|cpu-simd|mem|io> [num_processes] [--pin <spec>] [--numa <mode>]\n", program_name);
     fprintf(stderr, "\n");
     fprintf(stderr, "Arguments:\n");
     fprintf(stderr, "  <cpu|mem|io>     - Type of worker function to execute:\n");
     fprintf(stderr, "                     'cpu' for CPU-intensive operations\n");
+    fprintf(stderr, "                     'cpu-simd' for SIMD-vectorized CPU operations\n");
     fprintf(stderr, "                     'mem' for Memory-intensive operations\n");
+    fprintf(stderr, "                     'mem-arena' for Memory-intensive operations (arena allocator)\n");
+    fprintf(stderr, "                     'mem-huge'  for Memory-intensive operations (huge pages)\n");
     fprintf(stderr, "                     'io'  for I/O-intensive operations\n");
+    fprintf(stderr, "                     'io-uring' for I/O-intensive operations (async, O_DIRECT)\n");
+    fprintf(stderr, "                     'io-mmap'  for I/O-intensive operations (memory-mapped)\n");
     fprintf(stderr, "  [num_processes]  - Number of child processes to create (default: 2)\n");
+    fprintf(stderr, "  [--pin <spec>]   - Pin workers to CPUs: compact, scatter, or list:0,2,4\n");
+    fprintf(stderr, "  [--numa <mode>]  - Memory policy for workers: local or interleave\n");
+    fprintf(stderr, "  [--csv <file>]   - Measure in-process and append a row in the\n");
+    fprintf(stderr, "                     MT25077_Part_D_CSV.csv schema to <file>\n");
+    fprintf(stderr, "  [--mix <spec>]   - With worker type 'mix': interleaved duty cycle,\n");
+    fprintf(stderr, "                     e.g. --mix cpu:50,mem:30,io:20\n");
+    fprintf(stderr, "  [--tree <fanout>]- Spawn workers through a hierarchical fork tree\n");
+    fprintf(stderr, "                     with waitpid(-1) reaping; reports spawn throughput\n");
+    fprintf(stderr, "  [--bin <file>]   - Append a fixed-width binary record (crash-safe\n");
+    fprintf(stderr, "                     mmap writer); convert with: %s results-to-csv <file>\n", program_name);
+    fprintf(stderr, "  [--perf]         - Per-phase perf counters (cycles, instructions,\n");
+    fprintf(stderr, "                     LLC/dTLB misses) via perf_event_open; with --csv,\n");
+    fprintf(stderr, "                     phase rows go to <file>.phases.csv\n");
+    fprintf(stderr, "\n");
+    fprintf(stderr, "Pool mode:\n");
+    fprintf(stderr, "  %s pool [N]      - Fork N long-lived children once and dispatch\n", program_name);
+    fprintf(stderr, "                     jobs (\"<worker> <iterations>\" lines on stdin)\n");
+    fprintf(stderr, "                     over pipes, amortizing fork cost across a sweep\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "Examples:\n");
     fprintf(stderr, "  %s cpu           - Create 2 child processes running CPU worker\n", program_name);
@@ -51,6 +204,240 @@ void print_usage(const char *program_name) {
     exit(EXIT_FAILURE);
 }
 
+/*
+ * Map worker type to its chunked variant for pool jobs.
+ */
+worker_chunk_func_t get_worker_chunk_function(const char *worker_type) {
+    if (strcmp(worker_type, "cpu") == 0) {
+        return worker_cpu_chunk;
+    } else if (strcmp(worker_type, "cpu-simd") == 0) {
+        return worker_cpu_simd_chunk;
+    } else if (strcmp(worker_type, "mem") == 0) {
+        return worker_mem_chunk;
+    } else if (strcmp(worker_type, "io") == 0) {
+        return worker_io_chunk;
+    } else {
+        return NULL;
+    }
+}
+
+/*
+ * Pool child main loop: block on the job pipe, run each job with the
+ * matching chunked worker, answer with a completion record. A zero-length
+ * read (parent closed the pipe) is the shutdown signal.
+ */
+static void pool_child_loop(int job_fd, int result_fd) {
+    pool_job_t job;
+    ssize_t n;
+
+    while ((n = read(job_fd, &job, sizeof(job))) == (ssize_t)sizeof(job)) {
+        worker_chunk_func_t chunk_func = get_worker_chunk_function(job.worker);
+
+        pool_result_t result;
+        memset(&result, 0, sizeof(result));
+        result.job_id = job.job_id;
+        result.iterations = job.iterations;
+        memcpy(result.worker, job.worker, sizeof(result.worker));
+
+        struct timespec t0, t1;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &t0);
+        if (chunk_func != NULL) {
+            chunk_func(0, job.iterations);
+        } else {
+            result.iterations = -1;  /* unknown worker type */
+        }
+        clock_gettime(CLOCK_MONOTONIC_RAW, &t1);
+        result.duration_ns = (long long)(t1.tv_sec - t0.tv_sec) * 1000000000LL
+                             + (long long)(t1.tv_nsec - t0.tv_nsec);
+
+        if (write(result_fd, &result, sizeof(result)) != (ssize_t)sizeof(result)) {
+            break;  /* parent is gone */
+        }
+    }
+}
+
+/*
+ * Run pool mode in the parent: fork the children once, then dispatch
+ * stdin jobs to idle children and collect completion records until EOF.
+ * Returns the number of failed jobs.
+ */
+static int pool_run(int num_processes) {
+    int job_pipes[100][2];     /* parent writes jobs */
+    int result_pipes[100][2];  /* parent reads completions */
+    pid_t pids[100];
+    int busy[100];
+    int dead[100];            /* child crashed: never dispatch to it again */
+    long jobs_done_by[100];
+
+    printf("Creating pool of %d long-lived children...\n", num_processes);
+
+    /* Create every pipe before the first fork so no fd number is reused
+     * between children; each child then closes everything except its own
+     * job read end and result write end */
+    for (int i = 0; i < num_processes; i++) {
+        if (pipe(job_pipes[i]) != 0 || pipe(result_pipes[i]) != 0) {
+            fprintf(stderr, "Error: pipe() failed: %s\n", strerror(errno));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Flush before forking so children do not inherit buffered output */
+    fflush(stdout);
+
+    for (int i = 0; i < num_processes; i++) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            fprintf(stderr, "Error: fork() failed: %s\n", strerror(errno));
+            exit(EXIT_FAILURE);
+        } else if (pid == 0) {
+            /* Child: keep only its own pipe ends */
+            for (int j = 0; j < num_processes; j++) {
+                close(job_pipes[j][1]);
+                close(result_pipes[j][0]);
+                if (j != i) {
+                    close(job_pipes[j][0]);
+                    close(result_pipes[j][1]);
+                }
+            }
+            pool_child_loop(job_pipes[i][0], result_pipes[i][1]);
+            exit(EXIT_SUCCESS);
+        }
+
+        pids[i] = pid;
+        busy[i] = 0;
+        dead[i] = 0;
+        jobs_done_by[i] = 0;
+    }
+
+    /* Parent keeps only the job write ends and result read ends */
+    for (int i = 0; i < num_processes; i++) {
+        close(job_pipes[i][0]);
+        close(result_pipes[i][1]);
+        printf("  Pool child %d: PID = %d\n", i + 1, pids[i]);
+    }
+    printf("Reading jobs from stdin (\"<worker> <iterations>\" per line)...\n\n");
+
+    long next_job_id = 1;
+    long completed = 0;
+    long dispatched = 0;
+    int failed_jobs = 0;
+    int stdin_open = 1;
+
+    char line[128];
+    while (stdin_open || dispatched > completed) {
+        /* Fill idle children while jobs are available */
+        while (stdin_open) {
+            int idle = -1;
+            int alive = 0;
+            for (int i = 0; i < num_processes; i++) {
+                if (dead[i]) {
+                    continue;
+                }
+                alive++;
+                if (!busy[i] && idle < 0) {
+                    idle = i;
+                }
+            }
+            if (alive == 0) {
+                fprintf(stderr, "Error: all pool children died, aborting\n");
+                stdin_open = 0;
+                break;
+            }
+            if (idle < 0) {
+                break;  /* everyone busy: collect a completion first */
+            }
+
+            if (fgets(line, sizeof(line), stdin) == NULL) {
+                stdin_open = 0;
+                break;
+            }
+
+            pool_job_t job;
+            memset(&job, 0, sizeof(job));
+            if (sscanf(line, "%15s %ld", job.worker, &job.iterations) != 2
+                || job.iterations <= 0
+                || get_worker_chunk_function(job.worker) == NULL) {
+                fprintf(stderr, "Skipping malformed job line: %s", line);
+                failed_jobs++;
+                continue;
+            }
+            job.job_id = next_job_id++;
+
+            if (write(job_pipes[idle][1], &job, sizeof(job))
+                    != (ssize_t)sizeof(job)) {
+                fprintf(stderr, "Error: dispatch to child %d failed\n", idle + 1);
+                failed_jobs++;
+                continue;
+            }
+            busy[idle] = 1;
+            dispatched++;
+        }
+
+        if (dispatched == completed) {
+            continue;  /* stdin closed and nothing in flight */
+        }
+
+        /* Wait for any completion record */
+        struct pollfd pfds[100];
+        for (int i = 0; i < num_processes; i++) {
+            pfds[i].fd = busy[i] ? result_pipes[i][0] : -1;
+            pfds[i].events = POLLIN;
+        }
+        if (poll(pfds, (nfds_t)num_processes, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Error: poll() failed: %s\n", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < num_processes; i++) {
+            if (!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            pool_result_t result;
+            if (read(result_pipes[i][0], &result, sizeof(result))
+                    != (ssize_t)sizeof(result)) {
+                /* Child died mid-job (POLLHUP with no data): retire it so
+                 * the dispatcher never writes into a broken pipe */
+                fprintf(stderr, "Error: pool child %d died, retiring it\n", i + 1);
+                busy[i] = 0;
+                dead[i] = 1;
+                failed_jobs++;
+                completed++;
+                continue;
+            }
+            if (result.iterations < 0) {
+                fprintf(stderr, "  Job %ld: child %d rejected worker '%s'\n",
+                        result.job_id, i + 1, result.worker);
+                failed_jobs++;
+            } else {
+                printf("  Job %ld (%s, %ld iters) completed by child %d in %.3f s\n",
+                       result.job_id, result.worker, result.iterations, i + 1,
+                       (double)result.duration_ns / 1e9);
+            }
+            busy[i] = 0;
+            jobs_done_by[i]++;
+            completed++;
+        }
+    }
+
+    /* Shutdown: closing the job pipes is the children's EOF */
+    for (int i = 0; i < num_processes; i++) {
+        close(job_pipes[i][1]);
+    }
+    for (int i = 0; i < num_processes; i++) {
+        waitpid(pids[i], NULL, 0);
+        close(result_pipes[i][0]);
+    }
+
+    printf("\nPool summary: %ld jobs completed, %d failed\n", completed, failed_jobs);
+    for (int i = 0; i < num_processes; i++) {
+        printf("  Pool child %d: %ld jobs\n", i + 1, jobs_done_by[i]);
+    }
+    return failed_jobs;
+}
+
 /*
  * Parse worker type from command-line argument
  * Returns function pointer to the appropriate worker function
@@ -58,10 +445,20 @@ void print_usage(const char *program_name) {
 worker_func_t get_worker_function(const char *worker_type) {
     if (strcmp(worker_type, "cpu") == 0) {
         return worker_cpu;
+    } else if (strcmp(worker_type, "cpu-simd") == 0) {
+        return worker_cpu_simd;
     } else if (strcmp(worker_type, "mem") == 0) {
         return worker_mem;
+    } else if (strcmp(worker_type, "mem-arena") == 0) {
+        return worker_mem_arena;
+    } else if (strcmp(worker_type, "mem-huge") == 0) {
+        return worker_mem_huge;
     } else if (strcmp(worker_type, "io") == 0) {
         return worker_io;
+    } else if (strcmp(worker_type, "io-uring") == 0) {
+        return worker_io_uring;
+    } else if (strcmp(worker_type, "io-mmap") == 0) {
+        return worker_io_mmap;
     } else {
         return NULL;
     }
@@ -71,29 +468,136 @@ worker_func_t get_worker_function(const char *worker_type) {
  * Main function
  */
 int main(int argc, char *argv[]) {
+    /* Separate --pin/--numa options from the positional arguments */
+    pin_policy_t pin_policy;
+    pin_policy.mode = PIN_MODE_NONE;
+    const char *numa_mode = NULL;
+    const char *csv_path = NULL;
+    int perf_enabled = 0;
+    int tree_mode_fanout = 0;   /* 0 = flat spawn (default) */
+    const char *mix_spec = NULL;
+    const char *bin_path = NULL;
+    const char *positional[2];
+    int num_positional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--pin") == 0) {
+            if (i + 1 >= argc || pin_policy_parse(&pin_policy, argv[i + 1]) != 0) {
+                fprintf(stderr, "Error: --pin requires compact, scatter, or list:0,2,4\n\n");
+                print_usage(argv[0]);
+            }
+            i++;
+        } else if (strcmp(argv[i], "--numa") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --numa requires local or interleave\n\n");
+                print_usage(argv[0]);
+            }
+            numa_mode = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --csv requires an output file path\n\n");
+                print_usage(argv[0]);
+            }
+            csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--bin") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --bin requires an output file path\n\n");
+                print_usage(argv[0]);
+            }
+            bin_path = argv[++i];
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            perf_enabled = 1;
+        } else if (strcmp(argv[i], "--mix") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --mix requires a spec like cpu:50,mem:30,io:20\n\n");
+                print_usage(argv[0]);
+            }
+            mix_spec = argv[++i];
+        } else if (strcmp(argv[i], "--tree") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 2) {
+                fprintf(stderr, "Error: --tree requires a fan-out >= 2\n\n");
+                print_usage(argv[0]);
+            }
+            tree_mode_fanout = atoi(argv[++i]);
+        } else if (num_positional < 2) {
+            positional[num_positional++] = argv[i];
+        } else {
+            fprintf(stderr, "Error: Invalid number of arguments\n\n");
+            print_usage(argv[0]);
+        }
+    }
+
     /* Check command-line arguments */
-    if (argc < 2 || argc > 3) {
+    if (num_positional < 1) {
         fprintf(stderr, "Error: Invalid number of arguments\n\n");
         print_usage(argv[0]);
     }
 
     /* Parse worker type */
-    const char *worker_type = argv[1];
-    worker_func_t worker_func = get_worker_function(worker_type);
+    const char *worker_type = positional[0];
+
+    /* Converter mode: results-to-csv <results.bin> <out.csv> */
+    if (strcmp(worker_type, "results-to-csv") == 0) {
+        if (num_positional < 2) {
+            fprintf(stderr, "Usage: %s results-to-csv <results.bin>\n", argv[0]);
+            fprintf(stderr, "       (CSV written to <results.bin>.csv)\n");
+            exit(EXIT_FAILURE);
+        }
+        char out_path[600];
+        snprintf(out_path, sizeof(out_path), "%s.csv", positional[1]);
+        return results_to_csv(positional[1], out_path) == 0
+                   ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    /* Pool mode: long-lived children, jobs dispatched from stdin */
+    if (strcmp(worker_type, "pool") == 0) {
+        int num_processes = DEFAULT_NUM_PROCESSES;
+        if (num_positional == 2) {
+            num_processes = atoi(positional[1]);
+            if (num_processes <= 0 || num_processes > 100) {
+                fprintf(stderr, "Error: Invalid number of processes '%s'\n",
+                        positional[1]);
+                fprintf(stderr, "Must be between 1 and 100\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        printf("=================================================================\n");
+        printf("Program A: Process-pool execution using fork() + pipes\n");
+        printf("Roll Number: MT25077\n");
+        printf("=================================================================\n");
+        return pool_run(num_processes) > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    /* Mixed duty-cycle mode: worker type "mix" with a --mix spec */
+    if (strcmp(worker_type, "mix") == 0) {
+        if (mix_spec == NULL
+            || worker_mix_parse(&g_worker_mix, mix_spec) != 0) {
+            fprintf(stderr, "Error: worker type 'mix' requires a valid --mix spec\n\n");
+            print_usage(argv[0]);
+        }
+    } else if (mix_spec != NULL) {
+        fprintf(stderr, "Error: --mix is only valid with worker type 'mix'\n\n");
+        print_usage(argv[0]);
+    }
+
+    worker_func_t worker_func = (strcmp(worker_type, "mix") == 0)
+                                    ? worker_mix_entry
+                                    : get_worker_function(worker_type);
 
     if (worker_func == NULL) {
         fprintf(stderr, "Error: Invalid worker type '%s'\n", worker_type);
-        fprintf(stderr, "Must be one of: cpu, mem, io\n\n");
+        fprintf(stderr, "Must be one of: cpu, cpu-simd, mem, mem-arena, mem-huge, io, io-uring, io-mmap\n\n");
         print_usage(argv[0]);
     }
 
-    /* Parse number of processes (default: 2) */
+    /* Parse number of processes (default: 2). The old cap of 100 is gone:
+     * the fork tree exists precisely to spawn thousands of workers */
     int num_processes = DEFAULT_NUM_PROCESSES;
-    if (argc == 3) {
-        num_processes = atoi(argv[2]);
-        if (num_processes <= 0 || num_processes > 100) {
-            fprintf(stderr, "Error: Invalid number of processes '%s'\n", argv[2]);
-            fprintf(stderr, "Must be between 1 and 100\n");
+    if (num_positional == 2) {
+        num_processes = atoi(positional[1]);
+        if (num_processes <= 0 || num_processes > 100000) {
+            fprintf(stderr, "Error: Invalid number of processes '%s'\n", positional[1]);
+            fprintf(stderr, "Must be between 1 and 100000\n");
             exit(EXIT_FAILURE);
         }
     }
@@ -106,10 +610,89 @@ int main(int argc, char *argv[]) {
     printf("Configuration:\n");
     printf("  Worker Type:       %s\n", worker_type);
     printf("  Number of Processes: %d child processes\n", num_processes);
+    if (tree_mode_fanout > 0) {
+        printf("  Spawn Mode:        fork tree, fan-out %d\n", tree_mode_fanout);
+    }
+    if (pin_policy.mode != PIN_MODE_NONE) {
+        printf("  CPU Pinning:       enabled\n");
+    }
+    if (numa_mode != NULL) {
+        printf("  NUMA Policy:       %s\n", numa_mode);
+    }
     printf("  Loop Count per Worker: %d iterations\n", LOOP_COUNT);
     printf("  Parent PID:        %d\n", getpid());
     printf("=================================================================\n\n");
 
+    /* Tree mode: spawn through intermediates, reap with waitpid(-1) */
+    if (tree_mode_fanout > 0) {
+        tree_fanout = tree_mode_fanout;
+        tree_worker_func = worker_func;
+        tree_pin_policy = &pin_policy;
+        tree_numa_mode = numa_mode;
+        tree_total_workers = num_processes;
+
+        /* Become the process-group leader so a failed tree node can abort
+         * the entire run with one kill(0) instead of deadlocking at the
+         * barrier with leaves missing */
+        if (setpgid(0, 0) != 0) {
+            fprintf(stderr, "Warning: setpgid failed: %s\n", strerror(errno));
+        }
+
+        /* Root joins the barrier as an extra member so barrier release
+         * marks the instant every leaf exists and is ready */
+        if (start_barrier_init(num_processes + 1, 1) != 0) {
+            fprintf(stderr, "Error: start barrier unavailable for tree mode\n");
+            exit(EXIT_FAILURE);
+        }
+
+        printf("Spawning %d workers through a fan-out-%d fork tree...\n",
+               num_processes, tree_mode_fanout);
+        fflush(stdout);
+
+        struct timespec spawn_t0, spawn_t1;
+        clock_gettime(CLOCK_MONOTONIC, &spawn_t0);
+
+        /* Root acts as the first intermediate */
+        int branches = num_processes < tree_mode_fanout
+                           ? num_processes : tree_mode_fanout;
+        int offset = 0;
+        for (int b = 0; b < branches; b++) {
+            int share = num_processes / branches
+                        + (b < num_processes % branches ? 1 : 0);
+            pid_t pid = fork();
+            if (pid < 0) {
+                fprintf(stderr, "Error: fork() failed at tree root: %s\n",
+                        strerror(errno));
+                kill(0, SIGKILL);
+                exit(EXIT_FAILURE);
+            } else if (pid == 0) {
+                exit(tree_spawn_range(offset, share) > 0
+                         ? EXIT_FAILURE : EXIT_SUCCESS);
+            }
+            offset += share;
+        }
+
+        start_barrier_wait();
+        clock_gettime(CLOCK_MONOTONIC, &spawn_t1);
+        double spawn_s = (double)(spawn_t1.tv_sec - spawn_t0.tv_sec)
+                         + (double)(spawn_t1.tv_nsec - spawn_t0.tv_nsec) / 1e9;
+        printf("All %d workers spawned in %.4f s (%.0f processes/sec)\n",
+               num_processes, spawn_s,
+               spawn_s > 0 ? (double)num_processes / spawn_s : 0.0);
+        fflush(stdout);
+
+        int failures = tree_reap_children();
+        start_barrier_destroy();
+
+        printf("\n=================================================================\n");
+        printf("Execution Summary:\n");
+        printf("  Total workers: %d (fork tree, fan-out %d)\n",
+               num_processes, tree_mode_fanout);
+        printf("  Failed subtrees: %d\n", failures);
+        printf("=================================================================\n");
+        return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     /* Array to store child PIDs */
     pid_t *child_pids = (pid_t *)malloc(num_processes * sizeof(pid_t));
     if (child_pids == NULL) {
@@ -119,6 +702,15 @@ int main(int argc, char *argv[]) {
 
     /* Create child processes */
     printf("Creating %d child processes...\n", num_processes);
+
+    /* Hold every child at a shared barrier until the last fork() lands,
+     * so compute intervals are not skewed by launch stagger */
+    if (start_barrier_init(num_processes, 1) != 0) {
+        fprintf(stderr, "Warning: start barrier unavailable, children start unsynchronized\n");
+    }
+
+    measure_sample_t run_sample;
+    measure_begin(&run_sample);
     for (int i = 0; i < num_processes; i++) {
         pid_t pid = fork();
 
@@ -127,8 +719,10 @@ int main(int argc, char *argv[]) {
             fprintf(stderr, "Error: fork() failed for process %d: %s\n",
                     i, strerror(errno));
 
-            /* Wait for any previously created children */
+            /* Already-created children are parked at the start barrier and
+             * would wait forever for the missing siblings; kill them */
             for (int j = 0; j < i; j++) {
+                kill(child_pids[j], SIGKILL);
                 waitpid(child_pids[j], NULL, 0);
             }
 
@@ -136,13 +730,50 @@ int main(int argc, char *argv[]) {
             exit(EXIT_FAILURE);
 
         } else if (pid == 0) {
-            /* Child process */
+            /* Child process: apply placement before any worker allocation */
+            if (pin_policy.mode != PIN_MODE_NONE) {
+                int cpu = pin_policy_apply(&pin_policy, i, num_processes);
+                if (cpu >= 0) {
+                    printf("  Child %d: PID = %d, pinned to CPU %d\n",
+                           i + 1, getpid(), cpu);
+                }
+            }
+            if (numa_mode != NULL) {
+                numa_policy_apply(numa_mode);
+            }
+
             printf("  Child %d: PID = %d, executing %s worker\n",
                    i + 1, getpid(), worker_type);
             fflush(stdout);
 
-            /* Execute worker function */
+            if (perf_enabled) {
+                perf_phase_thread_init();
+            }
+
+            /* Wait for all siblings, then run with stats attached */
+            start_barrier_wait();
+
+            worker_stats_t stats;
+            worker_stats_begin(&stats);
             worker_func();
+            worker_stats_end(&stats);
+
+            if (perf_enabled) {
+                perf_phase_report(worker_type);
+                if (csv_path != NULL) {
+                    char phases_path[600];
+                    snprintf(phases_path, sizeof(phases_path), "%s.phases.csv",
+                             csv_path);
+                    perf_phase_csv_append(phases_path, "a", worker_type);
+                }
+                perf_phase_thread_shutdown();
+            }
+
+            printf("  Child %d: %.3f s compute, %ld iterations, %.1f MB touched\n",
+                   i + 1, (double)(stats.end_ns - stats.start_ns) / 1e9,
+                   stats.iterations,
+                   (double)stats.bytes_touched / (1024.0 * 1024.0));
+            fflush(stdout);
 
             /* Child exits successfully */
             exit(EXIT_SUCCESS);
@@ -158,9 +789,24 @@ int main(int argc, char *argv[]) {
            getpid(), num_processes);
 
     int failed_count = 0;
+    measure_sample_t total_sample;
+    memset(&total_sample, 0, sizeof(total_sample));
     for (int i = 0; i < num_processes; i++) {
         int status;
-        pid_t terminated_pid = waitpid(child_pids[i], &status, 0);
+        struct rusage child_ru;
+        pid_t terminated_pid = wait4(child_pids[i], &status, 0, &child_ru);
+
+        if (terminated_pid >= 0) {
+            /* Per-child measurement from the rusage wait4() hands back */
+            measure_sample_t child_sample = run_sample;
+            measure_end_rusage(&child_sample, &child_ru);
+            if (csv_path != NULL) {
+                char label[32];
+                snprintf(label, sizeof(label), "Child PID %d", terminated_pid);
+                measure_print(&child_sample, label);
+            }
+            measure_accumulate(&total_sample, &child_sample);
+        }
 
         if (terminated_pid < 0) {
             fprintf(stderr, "Error: waitpid() failed for PID %d: %s\n",
@@ -182,6 +828,27 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    start_barrier_destroy();
+
+    /* Whole-run measurement row in the Part D CSV schema */
+    total_sample.wall_s = measure_wall_elapsed(&run_sample);
+    if (csv_path != NULL) {
+        if (measure_csv_append(csv_path, "a", worker_type, num_processes,
+                               &total_sample) == 0) {
+            printf("\nMeasurement row appended to %s\n", csv_path);
+        }
+    }
+    if (bin_path != NULL) {
+        results_writer_t writer;
+        if (results_open(&writer, bin_path) == 0) {
+            if (results_append(&writer, "a", worker_type, num_processes,
+                               &total_sample) == 0) {
+                printf("\nBinary record appended to %s\n", bin_path);
+            }
+            results_close(&writer);
+        }
+    }
+
     /* Cleanup */
     free(child_pids);
 
@@ -9,7 +9,7 @@
  * worker functions (CPU-intensive, Memory-intensive, or I/O-intensive)
  * in each thread.
  *
- * Usage: ./program_b <cpu|mem|io> [num_threads]
+ * Usage: ./program_b <cpu|cpu-simd|mem|io> [num_threads]
  *        - First argument specifies worker type: cpu, mem, or io
  *        - Second argument (optional) specifies number of threads (default: 2)
  *
@@ -17,39 +17,112 @@
  * For Part D: ./program_b <worker_type> <N>    (creates N threads)
  */
 
+#define _GNU_SOURCE  /* for CLOCK_MONOTONIC with -std=c11 */
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
 #include <errno.h>
 #include <unistd.h>
+#include <stdatomic.h>
+#include <time.h>
 #include "MT25077_Part_B_workers.h"
+#include "MT25077_Part_C_perf.h"
+#include "MT25077_Part_D_measure.h"
+#include "MT25077_Part_D_results.h"
 
 /* Default number of threads for Part C */
 #define DEFAULT_NUM_THREADS 2
 
+/* Iterations pulled from the shared budget per queue pop (--shared-budget) */
+#define SHARED_CHUNK_SIZE 64
+
 /* Function pointer type for worker functions */
 typedef void (*worker_func_t)(void);
 
+/* Function pointer type for chunked workers used in shared-budget mode */
+typedef void (*worker_chunk_func_t)(long start, long count);
+
 /* Structure to pass data to thread */
 typedef struct {
     int thread_id;
     worker_func_t worker_func;
     const char *worker_type;
+    /* Shared-budget mode: chunk kernel and per-thread statistics */
+    worker_chunk_func_t chunk_func;
+    long chunks_pulled;
+    long iters_done;
+    /* Per-thread measurement (RUSAGE_THREAD), filled before thread exit */
+    measure_sample_t sample;
+    /* Per-worker stats (timestamps, iterations, bytes), barrier-synced */
+    worker_stats_t stats;
 } thread_data_t;
 
+/*
+ * Shared-budget scheduler state
+ *
+ * One fixed budget of LOOP_COUNT iterations is split into
+ * SHARED_CHUNK_SIZE-iteration chunks that threads claim with a single
+ * atomic fetch-add (a lock-free shared queue). Total work is constant
+ * regardless of thread count, so wall-clock time across N gives real
+ * strong-scaling speedup instead of the default mode's N full runs.
+ */
+static atomic_long g_next_iteration;
+static long g_total_iterations;
+
+/* Placement options, read by every thread at startup */
+static pin_policy_t g_pin_policy;
+static const char *g_numa_mode;
+static int g_num_threads;
+
+/* In-process measurement CSV output (--csv), NULL when disabled */
+static const char *g_csv_path;
+
+/* Binary results output (--bin), NULL when disabled */
+static const char *g_bin_path;
+
+/* Per-phase perf counters (--perf) */
+static int g_perf_enabled;
+
+/* Mixed duty-cycle configuration (worker type "mix") */
+static worker_mix_t g_worker_mix;
+static const char *g_mix_spec;
+
+static void worker_mix_entry(void) {
+    worker_mix_run(&g_worker_mix);
+}
+
 /*
  * Print usage information and exit
  */
 void print_usage(const char *program_name) {
-    fprintf(stderr, "Usage: %s <cpu|mem|io> [num_threads]\n", program_name);
+    fprintf(stderr, "Usage: %s <cpu|cpu-simd|mem|io> [num_threads] [--shared-budget] [--pin <spec>] [--numa <mode>]\n", program_name);
     fprintf(stderr, "\n");
     fprintf(stderr, "Arguments:\n");
     fprintf(stderr, "  <cpu|mem|io>  - Type of worker function to execute:\n");
     fprintf(stderr, "                  'cpu' for CPU-intensive operations\n");
+    fprintf(stderr, "                  'cpu-simd' for SIMD-vectorized CPU operations\n");
     fprintf(stderr, "                  'mem' for Memory-intensive operations\n");
+    fprintf(stderr, "                  'mem-arena' for Memory-intensive operations (arena allocator)\n");
+    fprintf(stderr, "                  'mem-huge'  for Memory-intensive operations (huge pages)\n");
     fprintf(stderr, "                  'io'  for I/O-intensive operations\n");
+    fprintf(stderr, "                  'io-uring' for I/O-intensive operations (async, O_DIRECT)\n");
+    fprintf(stderr, "                  'io-mmap'  for I/O-intensive operations (memory-mapped)\n");
     fprintf(stderr, "  [num_threads] - Number of threads to create (default: 2)\n");
+    fprintf(stderr, "  [--shared-budget] - Split one fixed %d-iteration budget across\n", LOOP_COUNT);
+    fprintf(stderr, "                  all threads in chunks pulled from a shared queue\n");
+    fprintf(stderr, "                  (strong scaling) instead of a full run per thread\n");
+    fprintf(stderr, "  [--pin <spec>]  - Pin threads to CPUs: compact, scatter, or list:0,2,4\n");
+    fprintf(stderr, "  [--numa <mode>] - Memory policy for threads: local or interleave\n");
+    fprintf(stderr, "  [--csv <file>]  - Measure in-process and append a row in the\n");
+    fprintf(stderr, "                  MT25077_Part_D_CSV.csv schema to <file>\n");
+    fprintf(stderr, "  [--mix <spec>]  - With worker type 'mix': interleaved duty cycle,\n");
+    fprintf(stderr, "                  e.g. --mix cpu:50,mem:30,io:20\n");
+    fprintf(stderr, "  [--bin <file>]  - Append a fixed-width binary record (crash-safe\n");
+    fprintf(stderr, "                  mmap writer); convert with program_a results-to-csv\n");
+    fprintf(stderr, "  [--perf]        - Per-phase perf counters via perf_event_open;\n");
+    fprintf(stderr, "                  with --csv, phase rows go to <file>.phases.csv\n");
     fprintf(stderr, "\n");
     fprintf(stderr, "Examples:\n");
     fprintf(stderr, "  %s cpu        - Create 2 threads running CPU worker\n", program_name);
@@ -57,6 +130,24 @@ void print_usage(const char *program_name) {
     exit(EXIT_FAILURE);
 }
 
+/*
+ * Map worker type to its chunked variant for shared-budget mode.
+ * Only workers with a chunk entry point can split the shared budget.
+ */
+worker_chunk_func_t get_worker_chunk_function(const char *worker_type) {
+    if (strcmp(worker_type, "cpu") == 0) {
+        return worker_cpu_chunk;
+    } else if (strcmp(worker_type, "cpu-simd") == 0) {
+        return worker_cpu_simd_chunk;
+    } else if (strcmp(worker_type, "mem") == 0) {
+        return worker_mem_chunk;
+    } else if (strcmp(worker_type, "io") == 0) {
+        return worker_io_chunk;
+    } else {
+        return NULL;
+    }
+}
+
 /*
  * Parse worker type from command-line argument
  * Returns function pointer to the appropriate worker function
@@ -64,10 +155,20 @@ void print_usage(const char *program_name) {
 worker_func_t get_worker_function(const char *worker_type) {
     if (strcmp(worker_type, "cpu") == 0) {
         return worker_cpu;
+    } else if (strcmp(worker_type, "cpu-simd") == 0) {
+        return worker_cpu_simd;
     } else if (strcmp(worker_type, "mem") == 0) {
         return worker_mem;
+    } else if (strcmp(worker_type, "mem-arena") == 0) {
+        return worker_mem_arena;
+    } else if (strcmp(worker_type, "mem-huge") == 0) {
+        return worker_mem_huge;
     } else if (strcmp(worker_type, "io") == 0) {
         return worker_io;
+    } else if (strcmp(worker_type, "io-uring") == 0) {
+        return worker_io_uring;
+    } else if (strcmp(worker_type, "io-mmap") == 0) {
+        return worker_io_mmap;
     } else {
         return NULL;
     }
@@ -84,8 +185,63 @@ void *thread_function(void *arg) {
            data->thread_id, (unsigned long)pthread_self(), data->worker_type);
     fflush(stdout);
 
-    /* Execute worker function */
-    data->worker_func();
+    /* Apply placement before the worker touches any memory */
+    if (g_pin_policy.mode != PIN_MODE_NONE) {
+        int cpu = pin_policy_apply(&g_pin_policy, data->thread_id - 1,
+                                   g_num_threads);
+        if (cpu >= 0) {
+            printf("  Thread %d: pinned to CPU %d\n", data->thread_id, cpu);
+        }
+    }
+    if (g_numa_mode != NULL) {
+        numa_policy_apply(g_numa_mode);
+    }
+
+    if (g_perf_enabled) {
+        perf_phase_thread_init();
+    }
+
+    /* Wait for all sibling threads, then run with stats attached */
+    start_barrier_wait();
+
+    measure_begin(&data->sample);
+    worker_stats_begin(&data->stats);
+
+    if (data->chunk_func != NULL) {
+        /* Shared-budget mode: pull chunks off the shared queue until the
+         * budget is exhausted. The atomic fetch-add is the whole queue. */
+        for (;;) {
+            long start = atomic_fetch_add(&g_next_iteration, SHARED_CHUNK_SIZE);
+            if (start >= g_total_iterations) {
+                break;
+            }
+            long count = SHARED_CHUNK_SIZE;
+            if (start + count > g_total_iterations) {
+                count = g_total_iterations - start;
+            }
+            data->chunk_func(start, count);
+            data->chunks_pulled++;
+            data->iters_done += count;
+        }
+    } else {
+        /* Default mode: one full worker run per thread */
+        data->worker_func();
+    }
+
+    /* Capture this thread's own counters before it exits */
+    worker_stats_end(&data->stats);
+    measure_end_thread(&data->sample);
+
+    if (g_perf_enabled) {
+        perf_phase_report(data->worker_type);
+        if (g_csv_path != NULL) {
+            char phases_path[600];
+            snprintf(phases_path, sizeof(phases_path), "%s.phases.csv",
+                     g_csv_path);
+            perf_phase_csv_append(phases_path, "b", data->worker_type);
+        }
+        perf_phase_thread_shutdown();
+    }
 
     /* Thread exits */
     pthread_exit(NULL);
@@ -95,32 +251,111 @@ void *thread_function(void *arg) {
  * Main function
  */
 int main(int argc, char *argv[]) {
+    /* Separate options from the positional arguments */
+    int shared_budget = 0;
+    g_pin_policy.mode = PIN_MODE_NONE;
+    g_numa_mode = NULL;
+    const char *positional[2];
+    int num_positional = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--shared-budget") == 0) {
+            shared_budget = 1;
+        } else if (strcmp(argv[i], "--pin") == 0) {
+            if (i + 1 >= argc || pin_policy_parse(&g_pin_policy, argv[i + 1]) != 0) {
+                fprintf(stderr, "Error: --pin requires compact, scatter, or list:0,2,4\n\n");
+                print_usage(argv[0]);
+            }
+            i++;
+        } else if (strcmp(argv[i], "--numa") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --numa requires local or interleave\n\n");
+                print_usage(argv[0]);
+            }
+            g_numa_mode = argv[++i];
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --csv requires an output file path\n\n");
+                print_usage(argv[0]);
+            }
+            g_csv_path = argv[++i];
+        } else if (strcmp(argv[i], "--bin") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --bin requires an output file path\n\n");
+                print_usage(argv[0]);
+            }
+            g_bin_path = argv[++i];
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            g_perf_enabled = 1;
+        } else if (strcmp(argv[i], "--mix") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Error: --mix requires a spec like cpu:50,mem:30,io:20\n\n");
+                print_usage(argv[0]);
+            }
+            g_mix_spec = argv[++i];
+        } else if (num_positional < 2) {
+            positional[num_positional++] = argv[i];
+        } else {
+            fprintf(stderr, "Error: Invalid number of arguments\n\n");
+            print_usage(argv[0]);
+        }
+    }
+
     /* Check command-line arguments */
-    if (argc < 2 || argc > 3) {
+    if (num_positional < 1) {
         fprintf(stderr, "Error: Invalid number of arguments\n\n");
         print_usage(argv[0]);
     }
 
     /* Parse worker type */
-    const char *worker_type = argv[1];
-    worker_func_t worker_func = get_worker_function(worker_type);
+    const char *worker_type = positional[0];
+
+    /* Mixed duty-cycle mode: worker type "mix" with a --mix spec */
+    if (strcmp(worker_type, "mix") == 0) {
+        if (g_mix_spec == NULL
+            || worker_mix_parse(&g_worker_mix, g_mix_spec) != 0) {
+            fprintf(stderr, "Error: worker type 'mix' requires a valid --mix spec\n\n");
+            print_usage(argv[0]);
+        }
+    } else if (g_mix_spec != NULL) {
+        fprintf(stderr, "Error: --mix is only valid with worker type 'mix'\n\n");
+        print_usage(argv[0]);
+    }
+
+    worker_func_t worker_func = (strcmp(worker_type, "mix") == 0)
+                                    ? worker_mix_entry
+                                    : get_worker_function(worker_type);
 
     if (worker_func == NULL) {
         fprintf(stderr, "Error: Invalid worker type '%s'\n", worker_type);
-        fprintf(stderr, "Must be one of: cpu, mem, io\n\n");
+        fprintf(stderr, "Must be one of: cpu, cpu-simd, mem, mem-arena, mem-huge, io, io-uring, io-mmap\n\n");
         print_usage(argv[0]);
     }
 
+    /* Shared-budget mode needs a chunked variant of the worker */
+    worker_chunk_func_t chunk_func = NULL;
+    if (shared_budget) {
+        chunk_func = get_worker_chunk_function(worker_type);
+        if (chunk_func == NULL) {
+            fprintf(stderr, "Error: worker type '%s' does not support --shared-budget\n", worker_type);
+            fprintf(stderr, "Chunked workers: cpu, cpu-simd, mem, io\n");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&g_next_iteration, 0);
+        g_total_iterations = LOOP_COUNT;
+    }
+
     /* Parse number of threads (default: 2) */
     int num_threads = DEFAULT_NUM_THREADS;
-    if (argc == 3) {
-        num_threads = atoi(argv[2]);
+    if (num_positional == 2) {
+        num_threads = atoi(positional[1]);
         if (num_threads <= 0 || num_threads > 100) {
-            fprintf(stderr, "Error: Invalid number of threads '%s'\n", argv[2]);
+            fprintf(stderr, "Error: Invalid number of threads '%s'\n", positional[1]);
             fprintf(stderr, "Must be between 1 and 100\n");
             exit(EXIT_FAILURE);
         }
     }
+    g_num_threads = num_threads;
 
     /* Display configuration */
     printf("=================================================================\n");
@@ -130,7 +365,18 @@ int main(int argc, char *argv[]) {
     printf("Configuration:\n");
     printf("  Worker Type:       %s\n", worker_type);
     printf("  Number of Threads: %d threads\n", num_threads);
-    printf("  Loop Count per Worker: %d iterations\n", LOOP_COUNT);
+    if (g_pin_policy.mode != PIN_MODE_NONE) {
+        printf("  CPU Pinning:       enabled\n");
+    }
+    if (g_numa_mode != NULL) {
+        printf("  NUMA Policy:       %s\n", g_numa_mode);
+    }
+    if (shared_budget) {
+        printf("  Scheduling:        shared budget of %d iterations, chunks of %d\n",
+               LOOP_COUNT, SHARED_CHUNK_SIZE);
+    } else {
+        printf("  Loop Count per Worker: %d iterations\n", LOOP_COUNT);
+    }
     printf("  Main Thread ID:    %lu\n", (unsigned long)pthread_self());
     printf("  Process PID:       %d\n", getpid());
     printf("=================================================================\n\n");
@@ -148,12 +394,23 @@ int main(int argc, char *argv[]) {
 
     /* Create threads */
     printf("Creating %d threads...\n", num_threads);
+
+    /* Hold every thread at a barrier until the last pthread_create lands */
+    if (start_barrier_init(num_threads, 0) != 0) {
+        fprintf(stderr, "Warning: start barrier unavailable, threads start unsynchronized\n");
+    }
+
+    struct timespec run_start;
+    clock_gettime(CLOCK_MONOTONIC, &run_start);
     int created_count = 0;
     for (int i = 0; i < num_threads; i++) {
         /* Initialize thread data */
         thread_data[i].thread_id = i + 1;
         thread_data[i].worker_func = worker_func;
         thread_data[i].worker_type = worker_type;
+        thread_data[i].chunk_func = chunk_func;
+        thread_data[i].chunks_pulled = 0;
+        thread_data[i].iters_done = 0;
 
         /* Create thread */
         int result = pthread_create(&threads[i], NULL, thread_function, &thread_data[i]);
@@ -193,9 +450,30 @@ int main(int argc, char *argv[]) {
         }
     }
 
-    /* Cleanup */
-    free(threads);
-    free(thread_data);
+    struct timespec run_end;
+    clock_gettime(CLOCK_MONOTONIC, &run_end);
+    double wall_s = (double)(run_end.tv_sec - run_start.tv_sec)
+                    + (double)(run_end.tv_nsec - run_start.tv_nsec) / 1e9;
+
+    start_barrier_destroy();
+
+    /* Per-worker stats: start offsets relative to the earliest worker show
+     * how tight the barrier release was */
+    long long min_start = 0;
+    for (int i = 0; i < num_threads; i++) {
+        if (i == 0 || thread_data[i].stats.start_ns < min_start) {
+            min_start = thread_data[i].stats.start_ns;
+        }
+    }
+    printf("\nPer-worker stats (barrier-synchronized start):\n");
+    for (int i = 0; i < num_threads; i++) {
+        const worker_stats_t *st = &thread_data[i].stats;
+        printf("  Thread %d: start offset %.1f us, %.3f s compute, %ld iterations, %.1f MB touched\n",
+               i + 1, (double)(st->start_ns - min_start) / 1e3,
+               (double)(st->end_ns - st->start_ns) / 1e9,
+               st->iterations,
+               (double)st->bytes_touched / (1024.0 * 1024.0));
+    }
 
     /* Print summary */
     printf("\n=================================================================\n");
@@ -203,8 +481,53 @@ int main(int argc, char *argv[]) {
     printf("  Total threads: %d\n", num_threads);
     printf("  Successful completions: %d\n", num_threads - failed_count);
     printf("  Failed threads: %d\n", failed_count);
+    if (g_csv_path != NULL || g_bin_path != NULL) {
+        /* Aggregate the per-thread samples into one Part D result row */
+        measure_sample_t total_sample;
+        memset(&total_sample, 0, sizeof(total_sample));
+        for (int i = 0; i < num_threads; i++) {
+            char label[24];
+            snprintf(label, sizeof(label), "Thread %d", i + 1);
+            measure_print(&thread_data[i].sample, label);
+        }
+        for (int i = 0; i < num_threads; i++) {
+            measure_accumulate(&total_sample, &thread_data[i].sample);
+        }
+        total_sample.wall_s = wall_s;
+        if (g_csv_path != NULL
+            && measure_csv_append(g_csv_path, "b", worker_type, num_threads,
+                                  &total_sample) == 0) {
+            printf("  Measurement row appended to %s\n", g_csv_path);
+        }
+        if (g_bin_path != NULL) {
+            results_writer_t writer;
+            if (results_open(&writer, g_bin_path) == 0) {
+                if (results_append(&writer, "b", worker_type, num_threads,
+                                   &total_sample) == 0) {
+                    printf("  Binary record appended to %s\n", g_bin_path);
+                }
+                results_close(&writer);
+            }
+        }
+    }
+    if (shared_budget) {
+        printf("  Shared budget: %ld iterations in %.3f s (%.1f iters/sec)\n",
+               g_total_iterations, wall_s, (double)g_total_iterations / wall_s);
+        printf("  Per-thread load balance (chunks / iterations):\n");
+        for (int i = 0; i < num_threads; i++) {
+            printf("    Thread %d: %ld chunks / %ld iterations\n",
+                   i + 1, thread_data[i].chunks_pulled, thread_data[i].iters_done);
+        }
+        printf("  Speedup vs 1 thread = T(1)/T(N): rerun with 1 thread for T(1)\n");
+    } else {
+        printf("  Wall-clock time: %.3f s\n", wall_s);
+    }
     printf("=================================================================\n");
 
+    /* Cleanup */
+    free(threads);
+    free(thread_data);
+
     /* Exit with appropriate status */
     if (failed_count > 0) {
         return EXIT_FAILURE;
@@ -12,7 +12,246 @@
  * - worker_io(): Stresses disk I/O with file read/write operations
  */
 
+#define _GNU_SOURCE  /* for MAP_ANONYMOUS / MAP_HUGETLB / madvise / CPU_SET */
+
 #include "MT25077_Part_B_workers.h"
+#include "MT25077_Part_C_perf.h"
+
+#include <errno.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/*
+ * CPU pinning and NUMA placement implementation
+ *
+ * Pinning uses sched_setaffinity(0, ...), which binds the calling thread
+ * only, so the same helper serves fork()ed children in Program A and
+ * pthreads in Program B. The NUMA policy goes through the set_mempolicy
+ * syscall directly so no libnuma dependency is added.
+ */
+
+/* set_mempolicy modes (mirrors <numaif.h>, avoided to skip the libnuma dep) */
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+#ifndef MPOL_LOCAL
+#define MPOL_LOCAL 4
+#endif
+
+int pin_policy_parse(pin_policy_t *policy, const char *spec) {
+    policy->mode = PIN_MODE_NONE;
+    policy->list_len = 0;
+
+    if (strcmp(spec, "compact") == 0) {
+        policy->mode = PIN_MODE_COMPACT;
+        return 0;
+    }
+    if (strcmp(spec, "scatter") == 0) {
+        policy->mode = PIN_MODE_SCATTER;
+        return 0;
+    }
+    if (strncmp(spec, "list:", 5) == 0) {
+        const char *p = spec + 5;
+        while (*p != '\0' && policy->list_len < PIN_MAX_CPUS) {
+            char *end;
+            long cpu = strtol(p, &end, 10);
+            if (end == p || cpu < 0 || cpu >= PIN_MAX_CPUS) {
+                return -1;  /* not a number, or out of range */
+            }
+            policy->cpu_list[policy->list_len++] = (int)cpu;
+            p = end;
+            if (*p == ',') {
+                p++;
+            } else if (*p != '\0') {
+                return -1;  /* junk between entries */
+            }
+        }
+        if (policy->list_len == 0) {
+            return -1;  /* empty list */
+        }
+        policy->mode = PIN_MODE_LIST;
+        return 0;
+    }
+    return -1;
+}
+
+int pin_policy_apply(const pin_policy_t *policy, int worker_index,
+                     int num_workers) {
+    if (policy->mode == PIN_MODE_NONE) {
+        return -1;
+    }
+
+    int ncpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpus < 1) {
+        ncpus = 1;
+    }
+
+    int cpu;
+    switch (policy->mode) {
+    case PIN_MODE_COMPACT:
+        /* Fill CPU IDs in order */
+        cpu = worker_index % ncpus;
+        break;
+    case PIN_MODE_SCATTER: {
+        /* Stride across the CPU ID space so workers land as far apart as
+         * possible; on typical socket-major enumerations this spreads
+         * them over sockets without reading the topology from sysfs */
+        int stride = ncpus / num_workers;
+        if (stride < 1) {
+            stride = 1;
+        }
+        cpu = (worker_index * stride) % ncpus;
+        break;
+    }
+    case PIN_MODE_LIST:
+    default:
+        /* Round-robin over the explicit list */
+        cpu = policy->cpu_list[worker_index % policy->list_len];
+        break;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        fprintf(stderr, "Failed to pin worker %d to CPU %d: %s\n",
+                worker_index, cpu, strerror(errno));
+        return -1;
+    }
+    return cpu;
+}
+
+int numa_policy_apply(const char *mode) {
+    if (strcmp(mode, "local") == 0) {
+        /* Allocate on the node of the CPU the worker is pinned to */
+        if (syscall(__NR_set_mempolicy, MPOL_LOCAL, NULL, 0UL) != 0) {
+            fprintf(stderr, "set_mempolicy(MPOL_LOCAL) failed: %s\n",
+                    strerror(errno));
+            return -1;
+        }
+        return 0;
+    }
+    if (strcmp(mode, "interleave") == 0) {
+        /* Interleave over all populated nodes. The kernel rejects masks
+         * naming absent nodes, so shrink the mask until it accepts one. */
+        for (int nodes = 8 * (int)sizeof(unsigned long); nodes >= 1; nodes /= 2) {
+            unsigned long mask = (nodes >= 8 * (int)sizeof(unsigned long))
+                                     ? ~0UL
+                                     : ((1UL << nodes) - 1);
+            if (syscall(__NR_set_mempolicy, MPOL_INTERLEAVE, &mask,
+                        (unsigned long)(8 * sizeof(unsigned long))) == 0) {
+                return 0;
+            }
+        }
+        fprintf(stderr, "set_mempolicy(MPOL_INTERLEAVE) failed: %s\n",
+                strerror(errno));
+        return -1;
+    }
+    fprintf(stderr, "Unknown NUMA policy '%s' (expected local or interleave)\n",
+            mode);
+    return -1;
+}
+
+/*
+ * Per-worker statistics and synchronized start implementation
+ *
+ * The stats pointer is thread-local so the record calls inside worker
+ * loops need no plumbing through every signature; fork()ed children
+ * inherit a copy of the parent's (detached) pointer and attach their own.
+ * The barrier lives in anonymous shared memory when process_shared is set
+ * so Program A's children all see the same barrier after fork().
+ */
+#include <pthread.h>
+
+static __thread worker_stats_t *tls_worker_stats;
+
+static long long monotonic_raw_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + (long long)ts.tv_nsec;
+}
+
+void worker_stats_begin(worker_stats_t *stats) {
+    stats->start_ns = monotonic_raw_ns();
+    stats->end_ns = 0;
+    stats->iterations = 0;
+    stats->bytes_touched = 0;
+    tls_worker_stats = stats;
+}
+
+void worker_stats_end(worker_stats_t *stats) {
+    stats->end_ns = monotonic_raw_ns();
+    tls_worker_stats = NULL;
+}
+
+void worker_stats_record(long iterations, long long bytes) {
+    if (tls_worker_stats != NULL) {
+        tls_worker_stats->iterations += iterations;
+        tls_worker_stats->bytes_touched += bytes;
+    }
+}
+
+static pthread_barrier_t *g_start_barrier;
+static int g_start_barrier_shared;
+
+int start_barrier_init(int num_workers, int process_shared) {
+    pthread_barrier_t *barrier;
+
+    if (process_shared) {
+        /* Anonymous shared mapping survives fork() as one shared object */
+        barrier = (pthread_barrier_t *)mmap(NULL, sizeof(*barrier),
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (barrier == MAP_FAILED) {
+            return -1;
+        }
+    } else {
+        barrier = (pthread_barrier_t *)malloc(sizeof(*barrier));
+        if (barrier == NULL) {
+            return -1;
+        }
+    }
+
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    if (process_shared) {
+        pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    }
+    if (pthread_barrier_init(barrier, &attr, (unsigned)num_workers) != 0) {
+        pthread_barrierattr_destroy(&attr);
+        if (process_shared) {
+            munmap(barrier, sizeof(*barrier));
+        } else {
+            free(barrier);
+        }
+        return -1;
+    }
+    pthread_barrierattr_destroy(&attr);
+
+    g_start_barrier = barrier;
+    g_start_barrier_shared = process_shared;
+    return 0;
+}
+
+void start_barrier_wait(void) {
+    if (g_start_barrier != NULL) {
+        pthread_barrier_wait(g_start_barrier);
+    }
+}
+
+void start_barrier_destroy(void) {
+    if (g_start_barrier == NULL) {
+        return;
+    }
+    pthread_barrier_destroy(g_start_barrier);
+    if (g_start_barrier_shared) {
+        munmap(g_start_barrier, sizeof(*g_start_barrier));
+    } else {
+        free(g_start_barrier);
+    }
+    g_start_barrier = NULL;
+}
 
 /*
  * Helper function for qsort in memory-intensive worker
@@ -41,12 +280,13 @@ int compare_int(const void *a, const void *b) {
  * The goal is to keep the CPU cores busy with continuous computation,
  * minimizing time spent waiting for memory or I/O.
  */
-void worker_cpu(void) {
+void worker_cpu_chunk(long start, long count) {
     double result = 0.0;
     double temp = 0.0;
 
-    /* Main computation loop - 7000 iterations */
-    for (long i = 1; i < LOOP_COUNT + 1; i++) {
+    /* Main computation loop - 'count' iterations starting at 'start' */
+    for (long i = start; i < start + count; i++) {
+        perf_phase_begin("cpu-transcend");
         /* Trigonometric calculations - CPU intensive */
         temp = sin((double)i);
         temp += cos((double)i);
@@ -75,19 +315,346 @@ void worker_cpu(void) {
 
         /* Accumulate result to prevent compiler optimization */
         result += temp / (double)(i + 1);
+        perf_phase_end();
 
         /* Additional nested computation to increase CPU load */
         /* Using CPU_INTENSIVE_MULTIPLIER to ensure long enough CPU burst for measurement */
+        perf_phase_begin("cpu-inner-loop");
         for (int j = 0; j < CPU_INTENSIVE_MULTIPLIER; j++) {
             temp = sqrt((double)(i + j)) * sin((double)j);
             result += temp / (double)(i + j + 1);
         }
+        perf_phase_end();
     }
 
     /* Print result to prevent compiler from optimizing away the entire computation */
     if (result > 0) {
         /* Result computed successfully */
     }
+
+    worker_stats_record(count, 0);
+}
+
+void worker_cpu(void) {
+    worker_cpu_chunk(1, LOOP_COUNT);
+}
+
+/*
+ * SIMD CPU-Intensive Worker Function
+ *
+ * Vectorized variant of worker_cpu(). The scalar worker issues one libm call
+ * at a time (sin, cos, pow, exp, ...), which keeps only a single FP pipeline
+ * busy and makes the burst length depend heavily on the host's libm and
+ * microarchitecture. This variant evaluates sin and cos with short polynomial
+ * approximations (range reduction + odd/even polynomials, accurate to ~1e-7,
+ * which is plenty for a load generator) so the compiler can keep several
+ * fused multiply-adds in flight per cycle.
+ *
+ * Dispatch is resolved once at runtime:
+ * - x86-64 with AVX2+FMA: 4-wide double vectors via immintrin.h
+ * - AArch64:              2-wide double vectors via NEON (arm_neon.h)
+ * - anything else:        the same polynomial evaluated in scalar code
+ *
+ * All three paths perform the identical arithmetic per lane, so the total
+ * FLOP budget matches the scalar worker's CPU_INTENSIVE_MULTIPLIER inner
+ * loop and results stay comparable across hosts.
+ */
+
+/* Polynomial coefficients for sin(x) on [-pi, pi] after range reduction */
+#define SIMD_SIN_C3 (-1.6666666666666632e-01)
+#define SIMD_SIN_C5 ( 8.3333333332211858e-03)
+#define SIMD_SIN_C7 (-1.9841269820235815e-04)
+#define SIMD_SIN_C9 ( 2.7557313707070068e-06)
+
+#define SIMD_TWO_PI     6.28318530717958647692
+#define SIMD_INV_TWO_PI 0.15915494309189533577
+#define SIMD_HALF_PI    1.57079632679489661923
+
+/*
+ * Scalar reference kernel: polynomial sin(x) + cos(x) for one lane.
+ * cos(x) is computed as sin(x + pi/2) so both share the reduction path.
+ */
+static inline double simd_poly_sin(double x) {
+    /* Reduce x into [-pi, pi] */
+    x -= SIMD_TWO_PI * nearbyint(x * SIMD_INV_TWO_PI);
+
+    double x2 = x * x;
+    double p = SIMD_SIN_C9;
+    p = p * x2 + SIMD_SIN_C7;
+    p = p * x2 + SIMD_SIN_C5;
+    p = p * x2 + SIMD_SIN_C3;
+    return x + x * x2 * p;
+}
+
+/*
+ * Scalar fallback kernel: processes 'count' lanes starting at 'base',
+ * accumulating sin + cos of a per-lane argument exactly like the vector
+ * paths below. Used when no SIMD extension is available at runtime.
+ */
+static double cpu_simd_kernel_scalar(long base, long count) {
+    double acc = 0.0;
+    for (long j = 0; j < count; j++) {
+        double x = (double)(base + j) * 0.001;
+        acc += simd_poly_sin(x);
+        acc += simd_poly_sin(x + SIMD_HALF_PI);  /* cos(x) */
+    }
+    return acc;
+}
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+/*
+ * AVX2+FMA kernel: identical arithmetic to the scalar kernel, 4 lanes wide.
+ * Compiled with a target attribute so the rest of the file stays baseline.
+ */
+__attribute__((target("avx2,fma")))
+static double cpu_simd_kernel_avx2(long base, long count) {
+    const __m256d two_pi     = _mm256_set1_pd(SIMD_TWO_PI);
+    const __m256d inv_two_pi = _mm256_set1_pd(SIMD_INV_TWO_PI);
+    const __m256d half_pi    = _mm256_set1_pd(SIMD_HALF_PI);
+    const __m256d c3 = _mm256_set1_pd(SIMD_SIN_C3);
+    const __m256d c5 = _mm256_set1_pd(SIMD_SIN_C5);
+    const __m256d c7 = _mm256_set1_pd(SIMD_SIN_C7);
+    const __m256d c9 = _mm256_set1_pd(SIMD_SIN_C9);
+
+    __m256d acc = _mm256_setzero_pd();
+    long j = 0;
+
+    for (; j + 4 <= count; j += 4) {
+        __m256d x = _mm256_set_pd((double)(base + j + 3), (double)(base + j + 2),
+                                  (double)(base + j + 1), (double)(base + j));
+        x = _mm256_mul_pd(x, _mm256_set1_pd(0.001));
+
+        /* Two polynomial evaluations: sin(x) and sin(x + pi/2) == cos(x) */
+        for (int k = 0; k < 2; k++) {
+            __m256d xr = (k == 0) ? x : _mm256_add_pd(x, half_pi);
+
+            /* Range reduction into [-pi, pi] */
+            __m256d n = _mm256_round_pd(_mm256_mul_pd(xr, inv_two_pi),
+                                        _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            xr = _mm256_fnmadd_pd(n, two_pi, xr);
+
+            __m256d x2 = _mm256_mul_pd(xr, xr);
+            __m256d p = c9;
+            p = _mm256_fmadd_pd(p, x2, c7);
+            p = _mm256_fmadd_pd(p, x2, c5);
+            p = _mm256_fmadd_pd(p, x2, c3);
+            __m256d s = _mm256_fmadd_pd(_mm256_mul_pd(xr, x2), p, xr);
+
+            acc = _mm256_add_pd(acc, s);
+        }
+    }
+
+    /* Horizontal sum of the 4 accumulator lanes */
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double result = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    /* Scalar tail for counts not divisible by 4 */
+    if (j < count) {
+        result += cpu_simd_kernel_scalar(base + j, count - j);
+    }
+    return result;
+}
+#endif /* __x86_64__ */
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+/* NEON kernel: identical arithmetic to the scalar kernel, 2 lanes wide. */
+static double cpu_simd_kernel_neon(long base, long count) {
+    const float64x2_t two_pi     = vdupq_n_f64(SIMD_TWO_PI);
+    const float64x2_t inv_two_pi = vdupq_n_f64(SIMD_INV_TWO_PI);
+    const float64x2_t half_pi    = vdupq_n_f64(SIMD_HALF_PI);
+    const float64x2_t c3 = vdupq_n_f64(SIMD_SIN_C3);
+    const float64x2_t c5 = vdupq_n_f64(SIMD_SIN_C5);
+    const float64x2_t c7 = vdupq_n_f64(SIMD_SIN_C7);
+    const float64x2_t c9 = vdupq_n_f64(SIMD_SIN_C9);
+
+    float64x2_t acc = vdupq_n_f64(0.0);
+    long j = 0;
+
+    for (; j + 2 <= count; j += 2) {
+        double lane_vals[2] = { (double)(base + j) * 0.001,
+                                (double)(base + j + 1) * 0.001 };
+        float64x2_t x = vld1q_f64(lane_vals);
+
+        for (int k = 0; k < 2; k++) {
+            float64x2_t xr = (k == 0) ? x : vaddq_f64(x, half_pi);
+
+            /* Range reduction into [-pi, pi] */
+            float64x2_t n = vrndnq_f64(vmulq_f64(xr, inv_two_pi));
+            xr = vfmsq_f64(xr, n, two_pi);
+
+            float64x2_t x2 = vmulq_f64(xr, xr);
+            float64x2_t p = c9;
+            p = vfmaq_f64(c7, p, x2);
+            p = vfmaq_f64(c5, p, x2);
+            p = vfmaq_f64(c3, p, x2);
+            float64x2_t s = vfmaq_f64(xr, vmulq_f64(xr, x2), p);
+
+            acc = vaddq_f64(acc, s);
+        }
+    }
+
+    double result = vgetq_lane_f64(acc, 0) + vgetq_lane_f64(acc, 1);
+
+    /* Scalar tail for odd counts */
+    if (j < count) {
+        result += cpu_simd_kernel_scalar(base + j, count - j);
+    }
+    return result;
+}
+#endif /* __aarch64__ */
+
+/* Kernel signature shared by all dispatch targets */
+typedef double (*cpu_simd_kernel_t)(long base, long count);
+
+/*
+ * Resolve the best available kernel for this host. Called once per worker
+ * invocation; the check itself is cheap (CPUID on x86, compile-time on ARM).
+ */
+static cpu_simd_kernel_t cpu_simd_resolve_kernel(void) {
+#if defined(__x86_64__)
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return cpu_simd_kernel_avx2;
+    }
+#endif
+#if defined(__aarch64__)
+    return cpu_simd_kernel_neon;
+#endif
+    return cpu_simd_kernel_scalar;
+}
+
+void worker_cpu_simd_chunk(long start, long count) {
+    cpu_simd_kernel_t kernel = cpu_simd_resolve_kernel();
+    double result = 0.0;
+
+    /* Same outer structure as worker_cpu(): one kernel call per iteration,
+     * each burning CPU_INTENSIVE_MULTIPLIER lane-operations.
+     */
+    for (long i = start; i < start + count; i++) {
+        result += kernel(i, CPU_INTENSIVE_MULTIPLIER) / (double)(i + 1);
+    }
+
+    /* Prevent the compiler from optimizing away the entire computation */
+    if (result > 0) {
+        /* Result computed successfully */
+    }
+
+    worker_stats_record(count, 0);
+}
+
+void worker_cpu_simd(void) {
+    worker_cpu_simd_chunk(1, LOOP_COUNT);
+}
+
+/*
+ * Arena allocator implementation
+ *
+ * One contiguous allocation carved into fixed-size buffers, handed out with
+ * LIFO discipline. Initialization touches every page once (memset) so the
+ * kernel maps and zeroes them up front; after that, acquire/release are a
+ * pair of index updates and iterations reuse the same hot, faulted pages.
+ */
+int mem_arena_init(mem_arena_t *arena, size_t buf_size, int num_bufs) {
+    arena->base = (char *)malloc(buf_size * (size_t)num_bufs);
+    if (arena->base == NULL) {
+        return -1;
+    }
+
+    arena->buf_size = buf_size;
+    arena->num_bufs = num_bufs;
+    arena->next = 0;
+
+    /* Pre-fault every page so acquires never hit the page-fault path */
+    memset(arena->base, 0, buf_size * (size_t)num_bufs);
+
+    return 0;
+}
+
+void *mem_arena_acquire(mem_arena_t *arena) {
+    if (arena->next >= arena->num_bufs) {
+        return NULL;  /* all buffers in use */
+    }
+    return arena->base + (size_t)arena->next++ * arena->buf_size;
+}
+
+void mem_arena_release(mem_arena_t *arena, void *buf) {
+    /* LIFO discipline: only the most recent acquisition may be released */
+    if (arena->next > 0 &&
+        buf == arena->base + (size_t)(arena->next - 1) * arena->buf_size) {
+        arena->next--;
+    }
+}
+
+void mem_arena_destroy(mem_arena_t *arena) {
+    free(arena->base);
+    arena->base = NULL;
+    arena->num_bufs = 0;
+    arena->next = 0;
+}
+
+/*
+ * LSD radix sort engine
+ *
+ * qsort() calls compare_int() through a function pointer once per
+ * comparison - O(n log n) indirect calls and branch mispredictions - so
+ * the "memory-intensive" worker largely measures call dispatch, not
+ * memory traffic. The LSD radix sort below makes four counting passes
+ * over 8-bit digits with a 256-entry bucket table (fits in one or two
+ * cache lines' worth of L1 sets) and streams the array between the input
+ * and a scratch buffer, so its cost is dominated by sequential DRAM
+ * bandwidth. Selected per run with MT25077_SORT=radix (default remains
+ * qsort); the worker reports the effective sort bandwidth either way.
+ */
+
+/* Bias the sign bit so negative ints order correctly as unsigned keys */
+#define RADIX_SIGN_BIAS 0x80000000u
+
+static void radix_sort_ints(int *arr, int *scratch, size_t n) {
+    unsigned *src = (unsigned *)arr;
+    unsigned *dst = (unsigned *)scratch;
+
+    /* Four stable passes, least significant digit first; an even number
+     * of passes leaves the sorted data back in 'arr' */
+    for (int shift = 0; shift < 32; shift += 8) {
+        size_t count[256] = {0};
+
+        for (size_t i = 0; i < n; i++) {
+            count[((src[i] ^ RADIX_SIGN_BIAS) >> shift) & 0xFF]++;
+        }
+
+        /* Exclusive prefix sum turns counts into scatter offsets */
+        size_t total = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = count[b];
+            count[b] = total;
+            total += c;
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            dst[count[((src[i] ^ RADIX_SIGN_BIAS) >> shift) & 0xFF]++] = src[i];
+        }
+
+        unsigned *swap = src;
+        src = dst;
+        dst = swap;
+    }
+}
+
+/* Sort engine selection, read once per worker run from MT25077_SORT */
+static int mem_sort_use_radix(void) {
+    const char *env = getenv("MT25077_SORT");
+    if (env == NULL || strcmp(env, "qsort") == 0) {
+        return 0;
+    }
+    if (strcmp(env, "radix") == 0) {
+        return 1;
+    }
+    fprintf(stderr, "Ignoring unknown MT25077_SORT value '%s' (qsort|radix)\n", env);
+    return 0;
 }
 
 /*
@@ -103,39 +670,73 @@ void worker_cpu(void) {
  * The goal is to create memory pressure and cause frequent cache misses,
  * making the memory subsystem the bottleneck rather than the CPU.
  */
-void worker_mem(void) {
+/*
+ * Shared body for worker_mem(), worker_mem_arena(), and worker_mem_chunk().
+ * Runs iterations [start, start + count). When arena is NULL each iteration
+ * malloc/frees its two buffers (original behavior); otherwise both buffers
+ * come from the pre-faulted arena and are reused across all iterations.
+ */
+static void worker_mem_run(mem_arena_t *arena, long start, long count) {
     /* Size of array to allocate per iteration (in integers)
      * Approximately 5 MB per iteration (5 * 256 * 1024 integers = 5MB)
      */
     const size_t array_size = 256 * 1024;  /* 1 MB per iteration */
 
-    /* Main memory operations loop - 7000 iterations */
-    for (long i = 0; i < LOOP_COUNT; i++) {
+    /* Sort engine: qsort (default) or LSD radix via MT25077_SORT=radix */
+    const int use_radix = mem_sort_use_radix();
+    long long sort_ns = 0;
+    long sorts_done = 0;
+
+    /* Main memory operations loop */
+    for (long i = start; i < start + count; i++) {
         /* Allocate large array - causes memory pressure */
-        int *arr = (int *)malloc(array_size * sizeof(int));
+        int *arr = (arena != NULL)
+                       ? (int *)mem_arena_acquire(arena)
+                       : (int *)malloc(array_size * sizeof(int));
         if (arr == NULL) {
             fprintf(stderr, "Memory allocation failed at iteration %ld\n", i);
             continue;
         }
 
         /* Fill array with pseudo-random data - memory write intensive */
+        perf_phase_begin("mem-fill");
         for (size_t j = 0; j < array_size; j++) {
             arr[j] = (int)((i * array_size + j) % 1000000);
         }
+        perf_phase_end();
 
         /* Access memory in non-sequential pattern - causes cache misses */
+        perf_phase_begin("mem-scan");
         long sum = 0;
         for (size_t j = 0; j < array_size; j += 64) {  /* Jump by cache line size */
             sum += arr[j];
         }
+        perf_phase_end();
+
+        /* Allocate second array before sorting: the radix engine streams
+         * through it as scratch, and the copy below overwrites it anyway */
+        int *arr2 = (arena != NULL)
+                        ? (int *)mem_arena_acquire(arena)
+                        : (int *)malloc(array_size * sizeof(int));
 
         /* Sort array - extremely memory intensive operation */
-        qsort(arr, array_size, sizeof(int), compare_int);
+        struct timespec sort_t0, sort_t1;
+        clock_gettime(CLOCK_MONOTONIC, &sort_t0);
+        perf_phase_begin("mem-sort");
+        if (use_radix && arr2 != NULL) {
+            radix_sort_ints(arr, arr2, array_size);
+        } else {
+            qsort(arr, array_size, sizeof(int), compare_int);
+        }
+        perf_phase_end();
+        clock_gettime(CLOCK_MONOTONIC, &sort_t1);
+        sort_ns += (long long)(sort_t1.tv_sec - sort_t0.tv_sec) * 1000000000LL
+                   + (long long)(sort_t1.tv_nsec - sort_t0.tv_nsec);
+        sorts_done++;
 
-        /* Allocate second array for copying */
-        int *arr2 = (int *)malloc(array_size * sizeof(int));
         if (arr2 != NULL) {
             /* Memory copy operation - memory bandwidth intensive */
+            perf_phase_begin("mem-memcpy");
             memcpy(arr2, arr, array_size * sizeof(int));
 
             /* Access copied array to ensure operation completed */
@@ -143,14 +744,161 @@ void worker_mem(void) {
             for (size_t j = 0; j < array_size; j += 128) {
                 checksum += arr2[j];
             }
+            perf_phase_end();
 
             /* Free second array */
-            free(arr2);
+            if (arena != NULL) {
+                mem_arena_release(arena, arr2);
+            } else {
+                free(arr2);
+            }
         }
 
         /* Free allocated memory */
-        free(arr);
+        if (arena != NULL) {
+            mem_arena_release(arena, arr);
+        } else {
+            free(arr);
+        }
+    }
+
+    /* Two 1 MB buffers written/read per iteration */
+    worker_stats_record(count, (long long)count * 2 * (long long)(array_size * sizeof(int)));
+
+    /* Effective sort bandwidth: radix moves the array 8x (read + write,
+     * four passes); qsort's traffic is taken as n log2(n) element reads */
+    if (sorts_done > 0 && sort_ns > 0) {
+        double bytes_per_sort;
+        if (use_radix) {
+            bytes_per_sort = 8.0 * (double)(array_size * sizeof(int));
+        } else {
+            bytes_per_sort = (double)array_size * sizeof(int)
+                             * (log((double)array_size) / log(2.0));
+        }
+        printf("  mem sort engine: %s, %ld sorts, %.1f MB/s effective\n",
+               use_radix ? "radix" : "qsort",
+               sorts_done,
+               bytes_per_sort * (double)sorts_done
+                   / ((double)sort_ns / 1e9) / (1024.0 * 1024.0));
+        fflush(stdout);
+    }
+}
+
+void worker_mem(void) {
+    worker_mem_run(NULL, 0, LOOP_COUNT);
+}
+
+void worker_mem_chunk(long start, long count) {
+    worker_mem_run(NULL, start, count);
+}
+
+/*
+ * Arena-mode memory worker: both per-iteration buffers are drawn from a
+ * pre-faulted arena and reused for all LOOP_COUNT iterations, so the run
+ * measures DRAM and cache behavior rather than glibc allocator behavior.
+ */
+void worker_mem_arena(void) {
+    const size_t array_size = 256 * 1024;  /* must match worker_mem_run() */
+
+    mem_arena_t arena;
+    if (mem_arena_init(&arena, array_size * sizeof(int), 2) != 0) {
+        fprintf(stderr, "Failed to initialize memory arena\n");
+        return;
     }
+
+    worker_mem_run(&arena, 0, LOOP_COUNT);
+
+    mem_arena_destroy(&arena);
+}
+
+/*
+ * Huge-Page Memory-Intensive Worker Function
+ *
+ * worker_mem()'s 1 MB malloc'd arrays sit on 4 KB pages and fit in a few
+ * hundred dTLB entries, so its curves say nothing about the TLB pressure of
+ * heaps backed by 2 MB huge pages. This worker maps one large working set
+ * (default MEM_HUGE_DEFAULT_MB, override with the MT25077_HUGE_MB
+ * environment variable) with mmap + MAP_HUGETLB and walks it with:
+ * - a sequential pass at 4 KB stride (one touch per base page), and
+ * - a pseudo-random pass over cache lines (defeats prefetch and readahead),
+ * so the run is dominated by dTLB misses and page-walk latency.
+ *
+ * When hugetlbfs has no pages reserved (mmap fails with ENOMEM), it falls
+ * back to a normal anonymous mapping and requests transparent huge pages
+ * via madvise(MADV_HUGEPAGE), reporting which backing was used.
+ */
+void worker_mem_huge(void) {
+    /* Working-set size: environment override, default well beyond LLC */
+    size_t ws_mb = MEM_HUGE_DEFAULT_MB;
+    const char *env = getenv("MT25077_HUGE_MB");
+    if (env != NULL) {
+        long parsed = atol(env);
+        if (parsed > 0) {
+            ws_mb = (size_t)parsed;
+        } else {
+            fprintf(stderr, "Ignoring invalid MT25077_HUGE_MB value '%s'\n", env);
+        }
+    }
+    /* Round up to a whole number of 2 MB huge pages */
+    size_t ws_size = ((ws_mb * 1024 * 1024 + (2u << 20) - 1) / (2u << 20)) * (2u << 20);
+
+    /* Try explicit huge pages first */
+    const char *backing = "hugetlb (2 MB pages)";
+    char *region = (char *)mmap(NULL, ws_size, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (region == MAP_FAILED) {
+        /* No hugetlbfs pages reserved: fall back to THP via madvise */
+        backing = "anonymous + MADV_HUGEPAGE";
+        region = (char *)mmap(NULL, ws_size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            fprintf(stderr, "mmap of %zu MB working set failed\n", ws_size >> 20);
+            return;
+        }
+        if (madvise(region, ws_size, MADV_HUGEPAGE) != 0) {
+            backing = "anonymous (4 KB pages)";
+        }
+    }
+
+    printf("  mem-huge: %zu MB working set, backing: %s\n", ws_size >> 20, backing);
+    fflush(stdout);
+
+    /* Fault in and initialize the whole working set */
+    for (size_t off = 0; off < ws_size; off += 64) {
+        region[off] = (char)(off >> 6);
+    }
+
+    const size_t page_stride = 4096;             /* one touch per base page */
+    const size_t num_lines = ws_size / 64;       /* cache lines in the set */
+    volatile long checksum = 0;
+    size_t idx = 0;
+
+    /* Main access loop - 7000 iterations */
+    for (long i = 0; i < LOOP_COUNT; i++) {
+        /* Sequential pass: one access per 4 KB page stresses the dTLB at
+         * page-walk granularity while staying prefetch-friendly */
+        for (size_t off = 0; off < ws_size; off += page_stride) {
+            checksum += region[off];
+        }
+
+        /* Pseudo-random pass: 64K cache-line touches spread over the whole
+         * set (LCG stride), defeating both prefetch and TLB locality */
+        for (int j = 0; j < 65536; j++) {
+            idx = (idx * 1103515245u + 12345u + (size_t)i) % num_lines;
+            checksum += region[idx * 64];
+        }
+    }
+
+    if (checksum != 0) {
+        /* Checksum consumed to keep the access loops alive */
+    }
+
+    /* 64 bytes per touched cache line, both access patterns */
+    worker_stats_record(LOOP_COUNT,
+                        (long long)LOOP_COUNT * 64
+                            * ((long long)(ws_size / page_stride) + 65536));
+
+    munmap(region, ws_size);
 }
 
 /*
@@ -165,7 +913,7 @@ void worker_mem(void) {
  * The goal is to make the process spend most of its time waiting for
  * disk I/O operations to complete, rather than performing CPU computation.
  */
-void worker_io(void) {
+static void worker_io_run(long start, long count) {
     /* Create unique filename based on process/thread ID and timestamp */
     char filename[512];
     snprintf(filename, sizeof(filename), "/tmp/io_test_%d_%ld.dat",
@@ -185,9 +933,10 @@ void worker_io(void) {
         buffer[i] = (char)(i % 256);
     }
 
-    /* Main I/O loop - 7000 iterations */
-    for (long i = 0; i < LOOP_COUNT; i++) {
+    /* Main I/O loop */
+    for (long i = start; i < start + count; i++) {
         /* WRITE OPERATION - Open file for writing */
+        perf_phase_begin("io-write");
         FILE *fp = fopen(filename, "w");
         if (fp == NULL) {
             fprintf(stderr, "Failed to open file for writing: %s\n", filename);
@@ -205,8 +954,10 @@ void worker_io(void) {
         /* Flush to ensure data is written to disk */
         fflush(fp);
         fclose(fp);
+        perf_phase_end();
 
         /* READ OPERATION - Open file for reading */
+        perf_phase_begin("io-read");
         fp = fopen(filename, "r");
         if (fp == NULL) {
             fprintf(stderr, "Failed to open file for reading: %s\n", filename);
@@ -222,8 +973,12 @@ void worker_io(void) {
         }
 
         fclose(fp);
+        perf_phase_end();
     }
 
+    /* 1 MB written + 1 MB read per iteration */
+    worker_stats_record(count, (long long)count * 2 * 1024 * 1024);
+
     /* Cleanup: Remove temporary file */
     if (unlink(filename) != 0) {
         fprintf(stderr, "Warning: Failed to delete temporary file: %s\n", filename);
@@ -232,3 +987,560 @@ void worker_io(void) {
     /* Free buffer */
     free(buffer);
 }
+
+void worker_io(void) {
+    worker_io_run(0, LOOP_COUNT);
+}
+
+void worker_io_chunk(long start, long count) {
+    worker_io_run(start, count);
+}
+
+/*
+ * Asynchronous I/O-Intensive Worker Function (io_uring + O_DIRECT)
+ *
+ * worker_io() is synchronous buffered stdio: the same file is re-opened,
+ * rewritten, and re-read 7000 times, which mostly measures the page cache
+ * and the VFS open/close path at queue depth 1. This worker instead:
+ * - opens one file with O_DIRECT so transfers bypass the page cache,
+ * - keeps IO_URING_QUEUE_DEPTH 64 KB operations in flight through an
+ *   io_uring submission/completion ring (raw syscalls, no liburing
+ *   dependency), and
+ * - reports achieved IOPS and bandwidth for the write and read phases,
+ * so process-vs-thread scaling on NVMe reflects the device, not the cache.
+ *
+ * Total volume matches worker_io(): LOOP_COUNT iterations x 16 blocks of
+ * 64 KB per phase, striped across a span large enough to keep the full
+ * queue depth busy. Falls back to worker_io() if io_uring_setup() is
+ * unavailable, and to buffered I/O if the filesystem rejects O_DIRECT.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+/* Minimal raw-syscall io_uring state: one SQ/CQ pair plus the SQE array */
+typedef struct {
+    int ring_fd;
+    unsigned sq_entries;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned *sq_mask;
+    unsigned *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned *cq_mask;
+    struct io_uring_cqe *cqes;
+    void  *sq_ring_ptr;
+    size_t sq_ring_sz;
+    void  *cq_ring_ptr;
+    size_t cq_ring_sz;
+    size_t sqes_sz;
+} io_uring_ring_t;
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                        flags, NULL, 0);
+}
+
+/*
+ * Create the ring and map the three kernel regions (SQ ring, CQ ring, SQEs).
+ * Returns 0 on success, -1 if the kernel lacks io_uring.
+ */
+static int io_uring_ring_init(io_uring_ring_t *ring, unsigned entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+
+    ring->ring_fd = sys_io_uring_setup(entries, &p);
+    if (ring->ring_fd < 0) {
+        return -1;
+    }
+
+    ring->sq_ring_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_ring_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_sz    = p.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ring_ptr = mmap(NULL, ring->sq_ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_SQ_RING);
+    ring->cq_ring_ptr = mmap(NULL, ring->cq_ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_CQ_RING);
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_sz,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_SQES);
+    if (ring->sq_ring_ptr == MAP_FAILED || ring->cq_ring_ptr == MAP_FAILED ||
+        ring->sqes == MAP_FAILED) {
+        close(ring->ring_fd);
+        return -1;
+    }
+
+    char *sq = (char *)ring->sq_ring_ptr;
+    ring->sq_entries = p.sq_entries;
+    ring->sq_head  = (unsigned *)(sq + p.sq_off.head);
+    ring->sq_tail  = (unsigned *)(sq + p.sq_off.tail);
+    ring->sq_mask  = (unsigned *)(sq + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+
+    char *cq = (char *)ring->cq_ring_ptr;
+    ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    ring->cqes    = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+
+    return 0;
+}
+
+static void io_uring_ring_destroy(io_uring_ring_t *ring) {
+    munmap(ring->sq_ring_ptr, ring->sq_ring_sz);
+    munmap(ring->cq_ring_ptr, ring->cq_ring_sz);
+    munmap(ring->sqes, ring->sqes_sz);
+    close(ring->ring_fd);
+}
+
+/* Queue one read or write SQE; caller submits via io_uring_enter().
+ * user_data carries the buffer-slot index so completions can return the
+ * buffer to the free list. */
+static void io_uring_queue_rw(io_uring_ring_t *ring, int opcode, int fd,
+                              void *buf, unsigned len, off_t offset,
+                              int buf_idx) {
+    unsigned tail = *ring->sq_tail;
+    unsigned idx  = tail & *ring->sq_mask;
+
+    struct io_uring_sqe *sqe = &ring->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = (__u8)opcode;
+    sqe->fd        = fd;
+    sqe->addr      = (unsigned long)buf;
+    sqe->len       = len;
+    sqe->off       = (__u64)offset;
+    sqe->user_data = (__u64)buf_idx;
+
+    ring->sq_array[idx] = idx;
+    /* Publish the new tail after the SQE is fully written */
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Reap all available completions; returns the number reaped, counts failed
+ * operations (cqe->res < 0) into *errors, and pushes each completion's
+ * buffer slot (carried in user_data) back onto the free stack.
+ */
+static int io_uring_reap(io_uring_ring_t *ring, long *errors,
+                         int *free_stack, int *free_top) {
+    int reaped = 0;
+    unsigned head = *ring->cq_head;
+
+    while (head != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        if (cqe->res < 0) {
+            (*errors)++;
+        }
+        free_stack[(*free_top)++] = (int)cqe->user_data;
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+/*
+ * Run one phase (all writes or all reads) at full queue depth.
+ * Returns the number of failed operations.
+ */
+static long io_uring_run_phase(io_uring_ring_t *ring, int opcode, int fd,
+                               char **bufs, long total_ops, off_t span,
+                               const char *phase_name) {
+    long submitted = 0;
+    long completed = 0;
+    long errors = 0;
+    double start_us = 0.0;
+
+    /* Free-list of buffer slots: a buffer is only reissued once the
+     * completion that used it has been reaped */
+    int free_stack[IO_URING_QUEUE_DEPTH];
+    int free_top = IO_URING_QUEUE_DEPTH;
+    for (int i = 0; i < IO_URING_QUEUE_DEPTH; i++) {
+        free_stack[i] = i;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    start_us = (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+
+    while (completed < total_ops) {
+        /* Top up the queue to full depth */
+        unsigned to_submit = 0;
+        while (free_top > 0 && submitted < total_ops) {
+            int buf_idx = free_stack[--free_top];
+            off_t offset = (off_t)(submitted * IO_URING_BLOCK_SIZE) % span;
+            io_uring_queue_rw(ring, opcode, fd, bufs[buf_idx],
+                              IO_URING_BLOCK_SIZE, offset, buf_idx);
+            submitted++;
+            to_submit++;
+        }
+
+        /* Submit new SQEs and wait for at least one completion */
+        int ret = sys_io_uring_enter(ring->ring_fd, to_submit, 1,
+                                     IORING_ENTER_GETEVENTS);
+        if (ret < 0) {
+            fprintf(stderr, "io_uring_enter failed in %s phase: %s\n",
+                    phase_name, strerror(errno));
+            return errors + (total_ops - completed);
+        }
+
+        completed += io_uring_reap(ring, &errors, free_stack, &free_top);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double elapsed_s = ((double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3
+                        - start_us) / 1e6;
+    if (elapsed_s > 0.0) {
+        printf("  io-uring %s: %ld ops, %.0f IOPS, %.1f MB/s%s\n",
+               phase_name, total_ops, (double)total_ops / elapsed_s,
+               (double)total_ops * IO_URING_BLOCK_SIZE / (1024.0 * 1024.0)
+                   / elapsed_s,
+               errors > 0 ? " (with errors)" : "");
+        fflush(stdout);
+    }
+    return errors;
+}
+
+void worker_io_uring(void) {
+    io_uring_ring_t ring;
+
+    if (io_uring_ring_init(&ring, IO_URING_QUEUE_DEPTH) != 0) {
+        fprintf(stderr,
+                "io_uring unavailable (%s); falling back to buffered worker_io\n",
+                strerror(errno));
+        worker_io();
+        return;
+    }
+
+    /* Unique filename, same convention as worker_io() */
+    char filename[512];
+    snprintf(filename, sizeof(filename), "/tmp/io_uring_test_%d_%ld.dat",
+             getpid(), (long)time(NULL));
+
+    /* O_DIRECT needs the filesystem's cooperation; tmpfs rejects it */
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+    if (fd < 0 && errno == EINVAL) {
+        fprintf(stderr,
+                "O_DIRECT not supported on /tmp; using buffered descriptor\n");
+        fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    }
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open %s: %s\n", filename, strerror(errno));
+        io_uring_ring_destroy(&ring);
+        return;
+    }
+
+    /* One 4 KB-aligned buffer per queue slot (O_DIRECT requirement) */
+    char *bufs[IO_URING_QUEUE_DEPTH];
+    for (int i = 0; i < IO_URING_QUEUE_DEPTH; i++) {
+        if (posix_memalign((void **)&bufs[i], 4096, IO_URING_BLOCK_SIZE) != 0) {
+            fprintf(stderr, "Failed to allocate aligned I/O buffers\n");
+            for (int j = 0; j < i; j++) free(bufs[j]);
+            close(fd);
+            io_uring_ring_destroy(&ring);
+            return;
+        }
+        memset(bufs[i], i & 0xFF, IO_URING_BLOCK_SIZE);
+    }
+
+    /* Same total volume as worker_io(): 16 x 64 KB blocks per iteration,
+     * striped over a span wide enough to keep the whole queue depth busy */
+    const long total_ops = (long)LOOP_COUNT * 16;
+    const off_t span = (off_t)IO_URING_QUEUE_DEPTH * IO_URING_BLOCK_SIZE;
+
+    long errors = 0;
+    errors += io_uring_run_phase(&ring, IORING_OP_WRITE, fd, bufs,
+                                 total_ops, span, "write");
+    errors += io_uring_run_phase(&ring, IORING_OP_READ, fd, bufs,
+                                 total_ops, span, "read");
+
+    if (errors > 0) {
+        fprintf(stderr, "io-uring worker: %ld failed operations\n", errors);
+    }
+
+    /* Both phases moved total_ops blocks each */
+    worker_stats_record(2 * total_ops,
+                        2 * (long long)total_ops * IO_URING_BLOCK_SIZE);
+
+    for (int i = 0; i < IO_URING_QUEUE_DEPTH; i++) {
+        free(bufs[i]);
+    }
+    close(fd);
+    io_uring_ring_destroy(&ring);
+
+    if (unlink(filename) != 0) {
+        fprintf(stderr, "Warning: Failed to delete temporary file: %s\n", filename);
+    }
+}
+
+/*
+ * Memory-Mapped I/O-Intensive Worker Function
+ *
+ * worker_io() moves every byte through fread/fwrite; half our consumers use
+ * mmap instead, where the cost structure is page faults, readahead, and
+ * write-back rather than copy syscalls. This worker covers that path:
+ *
+ * Write phase: LOOP_COUNT iterations, each filling one 1 MB window of a
+ * mapped IO_MMAP_FILE_MB file (wrapping around the span) and flushing it
+ * with msync(MS_ASYNC); one MS_SYNC at the end makes the data durable.
+ *
+ * Read phase: the file is re-mapped before each pass so every page must be
+ * faulted in again:
+ * - sequential pass: touches pages in order, letting readahead batch faults,
+ * - random pass:     touches pages in LCG order, producing the minor-fault
+ *                    storm that dominates mapped-I/O consumers.
+ * Each pass reports the minor/major fault delta from getrusage().
+ */
+
+#include <sys/resource.h>
+
+/* One fault-counted read pass over a fresh private mapping of the file */
+static void io_mmap_read_pass(int fd, size_t file_size, int sequential,
+                              const char *pass_name) {
+    const size_t page_size = 4096;
+    const size_t num_pages = file_size / page_size;
+
+    char *map = (char *)mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "mmap for %s read pass failed: %s\n",
+                pass_name, strerror(errno));
+        return;
+    }
+
+    struct rusage before, after;
+    /* RUSAGE_THREAD keeps the fault deltas per-worker under program_b,
+     * where RUSAGE_SELF would mix all threads' faults together */
+    getrusage(RUSAGE_THREAD, &before);
+
+    volatile long checksum = 0;
+    if (sequential) {
+        for (size_t p = 0; p < num_pages; p++) {
+            checksum += map[p * page_size];
+        }
+    } else {
+        size_t idx = 1;
+        for (size_t p = 0; p < num_pages; p++) {
+            idx = (idx * 1103515245u + 12345u) % num_pages;
+            checksum += map[idx * page_size];
+        }
+    }
+
+    getrusage(RUSAGE_THREAD, &after);
+    printf("  io-mmap %s read: %zu pages, %ld minor / %ld major faults\n",
+           pass_name, num_pages,
+           after.ru_minflt - before.ru_minflt,
+           after.ru_majflt - before.ru_majflt);
+    fflush(stdout);
+
+    if (checksum != 0) {
+        /* Checksum consumed to keep the fault loop alive */
+    }
+
+    munmap(map, file_size);
+}
+
+void worker_io_mmap(void) {
+    const size_t window_size = 1024 * 1024;  /* 1 MB per iteration */
+    const size_t file_size = (size_t)IO_MMAP_FILE_MB * 1024 * 1024;
+
+    /* Unique filename, same convention as worker_io() */
+    char filename[512];
+    snprintf(filename, sizeof(filename), "/tmp/io_mmap_test_%d_%ld.dat",
+             getpid(), (long)time(NULL));
+
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open %s: %s\n", filename, strerror(errno));
+        return;
+    }
+
+    /* Size the file so stores through the mapping have backing pages */
+    if (ftruncate(fd, (off_t)file_size) != 0) {
+        fprintf(stderr, "ftruncate failed: %s\n", strerror(errno));
+        close(fd);
+        unlink(filename);
+        return;
+    }
+
+    char *map = (char *)mmap(NULL, file_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "mmap for write phase failed: %s\n", strerror(errno));
+        close(fd);
+        unlink(filename);
+        return;
+    }
+
+    /* WRITE PHASE - one 1 MB window per iteration, wrapping over the span */
+    const size_t num_windows = file_size / window_size;
+    for (long i = 0; i < LOOP_COUNT; i++) {
+        char *window = map + (size_t)(i % (long)num_windows) * window_size;
+
+        /* Fill the window through the mapping - stores become dirty pages */
+        memset(window, (int)(i & 0xFF), window_size);
+
+        /* Queue write-back without blocking the loop */
+        if (msync(window, window_size, MS_ASYNC) != 0) {
+            fprintf(stderr, "msync(MS_ASYNC) failed at iteration %ld\n", i);
+        }
+    }
+
+    /* Make the dataset durable before the read phase */
+    if (msync(map, file_size, MS_SYNC) != 0) {
+        fprintf(stderr, "msync(MS_SYNC) failed: %s\n", strerror(errno));
+    }
+    munmap(map, file_size);
+
+    /* READ PHASE - fresh mappings so every page is fault-driven */
+    io_mmap_read_pass(fd, file_size, 1, "sequential");
+    io_mmap_read_pass(fd, file_size, 0, "random");
+
+    /* Write phase windows plus one page-granular touch per read pass */
+    worker_stats_record(LOOP_COUNT,
+                        (long long)LOOP_COUNT * (long long)window_size
+                            + 2 * (long long)file_size / 4096 * 64);
+
+    close(fd);
+    if (unlink(filename) != 0) {
+        fprintf(stderr, "Warning: Failed to delete temporary file: %s\n", filename);
+    }
+}
+
+/*
+ * Mixed-Workload Duty Cycle
+ *
+ * See the header for the model. The parse step resolves each phase name
+ * to its chunked kernel once; the run step then walks rounds of
+ * MIX_ROUND_ITERATIONS iterations, giving every phase its weighted share
+ * per round so the phases interleave instead of running back to back.
+ * Each phase keeps its own cumulative start index so its iteration
+ * stream looks exactly like a contiguous run of that worker.
+ */
+
+/* Chunked kernel signature, matching the worker_*_chunk entry points */
+typedef void (*worker_chunk_fn_t)(long start, long count);
+
+/* Map a phase name to its chunked kernel; NULL for unknown names */
+static worker_chunk_fn_t mix_lookup_kernel(const char *name) {
+    if (strcmp(name, "cpu") == 0) {
+        return worker_cpu_chunk;
+    } else if (strcmp(name, "cpu-simd") == 0) {
+        return worker_cpu_simd_chunk;
+    } else if (strcmp(name, "mem") == 0) {
+        return worker_mem_chunk;
+    } else if (strcmp(name, "io") == 0) {
+        return worker_io_chunk;
+    }
+    return NULL;
+}
+
+int worker_mix_parse(worker_mix_t *mix, const char *spec) {
+    mix->num_phases = 0;
+
+    const char *p = spec;
+    while (*p != '\0') {
+        if (mix->num_phases >= MIX_MAX_PHASES) {
+            fprintf(stderr, "Mix spec has more than %d phases\n", MIX_MAX_PHASES);
+            return -1;
+        }
+
+        /* Phase name up to ':' */
+        const char *colon = strchr(p, ':');
+        if (colon == NULL || colon == p
+            || (size_t)(colon - p) >= sizeof(mix->names[0])) {
+            fprintf(stderr, "Malformed mix phase near '%s'\n", p);
+            return -1;
+        }
+        memcpy(mix->names[mix->num_phases], p, (size_t)(colon - p));
+        mix->names[mix->num_phases][colon - p] = '\0';
+
+        if (mix_lookup_kernel(mix->names[mix->num_phases]) == NULL) {
+            fprintf(stderr, "Unknown mix phase '%s' (cpu, cpu-simd, mem, io)\n",
+                    mix->names[mix->num_phases]);
+            return -1;
+        }
+
+        /* Weight after ':' */
+        char *end;
+        long weight = strtol(colon + 1, &end, 10);
+        if (end == colon + 1 || weight <= 0) {
+            fprintf(stderr, "Malformed mix weight near '%s'\n", colon + 1);
+            return -1;
+        }
+        mix->weights[mix->num_phases] = weight;
+        mix->num_phases++;
+
+        p = end;
+        if (*p == ',') {
+            p++;
+        } else if (*p != '\0') {
+            fprintf(stderr, "Malformed mix spec near '%s'\n", p);
+            return -1;
+        }
+    }
+
+    if (mix->num_phases == 0) {
+        fprintf(stderr, "Empty mix specification\n");
+        return -1;
+    }
+    return 0;
+}
+
+void worker_mix_run(const worker_mix_t *mix) {
+    worker_chunk_fn_t kernels[MIX_MAX_PHASES];
+    long remaining[MIX_MAX_PHASES];
+    long next_start[MIX_MAX_PHASES];
+    long weight_sum = 0;
+
+    for (int i = 0; i < mix->num_phases; i++) {
+        kernels[i] = mix_lookup_kernel(mix->names[i]);
+        weight_sum += mix->weights[i];
+    }
+
+    /* Split the LOOP_COUNT budget by weight, remainder to the first phase */
+    long allocated = 0;
+    for (int i = 0; i < mix->num_phases; i++) {
+        remaining[i] = (long)LOOP_COUNT * mix->weights[i] / weight_sum;
+        next_start[i] = 0;
+        allocated += remaining[i];
+    }
+    remaining[0] += LOOP_COUNT - allocated;
+
+    /* Interleave: every round gives each phase its weighted slice */
+    int work_left = 1;
+    while (work_left) {
+        work_left = 0;
+        for (int i = 0; i < mix->num_phases; i++) {
+            if (remaining[i] <= 0) {
+                continue;
+            }
+            long slice = MIX_ROUND_ITERATIONS * mix->weights[i] / weight_sum;
+            if (slice < 1) {
+                slice = 1;
+            }
+            if (slice > remaining[i]) {
+                slice = remaining[i];
+            }
+
+            kernels[i](next_start[i], slice);
+            next_start[i] += slice;
+            remaining[i] -= slice;
+            if (remaining[i] > 0) {
+                work_left = 1;
+            }
+        }
+    }
+}
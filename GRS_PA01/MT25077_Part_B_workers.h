@@ -34,6 +34,16 @@
  */
 void worker_cpu(void);
 
+/*
+ * SIMD CPU-intensive worker function
+ * Performs the same transcendental workload as worker_cpu() but evaluates
+ * sin/cos through vectorized polynomial approximations (AVX2 on x86-64,
+ * NEON on AArch64, with a scalar polynomial fallback selected at runtime).
+ * Saturates the floating-point units instead of serializing on libm calls,
+ * giving a shorter and more stable per-core burst across microarchitectures.
+ */
+void worker_cpu_simd(void);
+
 /*
  * Memory-intensive worker function
  * Allocates large memory blocks, initializes them, performs sorting operations,
@@ -41,6 +51,70 @@ void worker_cpu(void);
  */
 void worker_mem(void);
 
+/*
+ * Arena allocator for the memory-intensive worker
+ *
+ * worker_mem() malloc/frees two 1 MB buffers on every iteration, so much of
+ * its runtime is glibc mmap/munmap churn and page faults rather than memory
+ * bandwidth. The arena pre-allocates and pre-faults all buffers once and
+ * hands them out with stack (LIFO) discipline, so repeated iterations reuse
+ * the same hot pages and the worker measures DRAM/cache behavior instead of
+ * allocator behavior.
+ */
+typedef struct {
+    char  *base;       /* single allocation backing all buffers */
+    size_t buf_size;   /* size of each buffer in bytes */
+    int    num_bufs;   /* total buffers carved out of the arena */
+    int    next;       /* index of the next free buffer (LIFO) */
+} mem_arena_t;
+
+/*
+ * Initialize an arena of num_bufs buffers of buf_size bytes each.
+ * Pre-faults every page so later acquires never take a page fault.
+ * Returns 0 on success, -1 on allocation failure.
+ */
+int mem_arena_init(mem_arena_t *arena, size_t buf_size, int num_bufs);
+
+/*
+ * Acquire the next free buffer from the arena.
+ * Returns NULL if all buffers are in use.
+ */
+void *mem_arena_acquire(mem_arena_t *arena);
+
+/*
+ * Release the most recently acquired buffer back to the arena.
+ * Buffers must be released in reverse order of acquisition.
+ */
+void mem_arena_release(mem_arena_t *arena, void *buf);
+
+/*
+ * Free all arena memory.
+ */
+void mem_arena_destroy(mem_arena_t *arena);
+
+/*
+ * Memory-intensive worker function (arena mode)
+ * Same workload as worker_mem() but the two per-iteration buffers come from
+ * a pre-faulted arena reused across all iterations, removing malloc/free and
+ * page-fault overhead from the measurement.
+ */
+void worker_mem_arena(void);
+
+/* Default working-set size for worker_mem_huge(), in MB. Chosen to sit well
+ * beyond typical LLC sizes so the walk is bound by TLB misses and page walks.
+ * Override at runtime with the MT25077_HUGE_MB environment variable. */
+#define MEM_HUGE_DEFAULT_MB 64
+
+/*
+ * Huge-page memory-intensive worker function
+ * Maps its working set with mmap(MAP_HUGETLB) (2 MB pages), falling back to
+ * a normal anonymous mapping with madvise(MADV_HUGEPAGE) when hugetlbfs has
+ * no pages reserved. Walks the set with sequential page-stride and
+ * pseudo-random access patterns so the run exercises dTLB-miss and
+ * page-walk costs comparable to huge-page production heaps.
+ */
+void worker_mem_huge(void);
+
 /*
  * I/O-intensive worker function
  * Performs substantial disk read/write operations to temporary files,
@@ -48,6 +122,190 @@ void worker_mem(void);
  */
 void worker_io(void);
 
+/* Queue depth kept in flight by the io-uring worker */
+#define IO_URING_QUEUE_DEPTH 64
+
+/* Block size per io-uring operation (64 KB, matches worker_io's buffer) */
+#define IO_URING_BLOCK_SIZE (64 * 1024)
+
+/*
+ * Asynchronous I/O-intensive worker function (io_uring + O_DIRECT)
+ * Keeps IO_URING_QUEUE_DEPTH 64 KB writes (then reads) in flight against an
+ * O_DIRECT file through an io_uring submission/completion ring, bypassing
+ * the page cache so the run measures the device rather than the VFS
+ * open/close path. Reports achieved IOPS and bandwidth per phase. Falls
+ * back to worker_io() when the kernel lacks io_uring support.
+ */
+void worker_io_uring(void);
+
+/* File span mapped by the io-mmap worker, in MB. The per-iteration 1 MB
+ * write windows wrap around this span, matching worker_io's volume. */
+#define IO_MMAP_FILE_MB 64
+
+/*
+ * Memory-mapped I/O-intensive worker function
+ * Writes the per-iteration 1 MB dataset through an mmap'd file region with
+ * msync write-back, then reads it back through fresh mappings so every page
+ * arrives via a fault: once sequentially (readahead-friendly) and once in a
+ * pseudo-random order (minor-fault storm). Reports the fault counts seen by
+ * each read pass so Part C/D measurements cover the mapped-I/O path.
+ */
+void worker_io_mmap(void);
+
+/*
+ * Chunked worker entry points
+ *
+ * Each runs 'count' iterations of the corresponding worker's main loop
+ * starting at logical iteration 'start'. The full-run workers above are
+ * thin wrappers over these (e.g. worker_cpu() == worker_cpu_chunk(1,
+ * LOOP_COUNT)). Program B's shared-budget mode uses them to split one
+ * fixed iteration budget into chunks pulled from a shared queue, so total
+ * work stays constant as the thread count grows and real parallel speedup
+ * can be measured.
+ */
+void worker_cpu_chunk(long start, long count);
+void worker_cpu_simd_chunk(long start, long count);
+void worker_mem_chunk(long start, long count);
+void worker_io_chunk(long start, long count);
+
+/*
+ * Per-worker statistics and synchronized start
+ *
+ * Launch staggering used to be invisible: workers return void and the only
+ * signal was printf interleaving, so Part D curves at high N conflated
+ * fork()/pthread_create() stagger with compute time. Every worker now
+ * records into a worker_stats_t - start/end timestamps from
+ * CLOCK_MONOTONIC_RAW (immune to NTP slewing), iterations completed, and
+ * bytes touched - via a thread-local hook the harness attaches around the
+ * worker call. A start barrier (process-shared and mmap'd for Program A's
+ * children, a plain pthread_barrier_t for Program B's threads) holds all N
+ * workers until the last one is ready, so start_ns is comparable across
+ * workers and the measured interval is pure compute.
+ */
+typedef struct {
+    long long start_ns;       /* CLOCK_MONOTONIC_RAW at barrier release */
+    long long end_ns;         /* CLOCK_MONOTONIC_RAW at worker return */
+    long      iterations;     /* main-loop iterations completed */
+    long long bytes_touched;  /* bytes read+written by the workload */
+} worker_stats_t;
+
+/*
+ * Stamp start_ns, zero the counters, and attach 'stats' to the calling
+ * thread so the worker's worker_stats_record() calls accumulate into it.
+ */
+void worker_stats_begin(worker_stats_t *stats);
+
+/*
+ * Stamp end_ns and detach the calling thread's stats pointer.
+ */
+void worker_stats_end(worker_stats_t *stats);
+
+/*
+ * Called by workers to credit completed iterations and touched bytes to
+ * the attached stats. No-op when no stats are attached (e.g. a worker
+ * function called directly).
+ */
+void worker_stats_record(long iterations, long long bytes);
+
+/*
+ * Start barrier. init() creates a barrier for num_workers participants;
+ * process_shared selects a PTHREAD_PROCESS_SHARED barrier in anonymous
+ * shared memory (for fork()ed children) over a process-private one (for
+ * threads). Each worker calls start_barrier_wait() once before its
+ * workload. Returns 0 on success, -1 on failure (workers then start
+ * unsynchronized, which matches the old behavior).
+ */
+int start_barrier_init(int num_workers, int process_shared);
+void start_barrier_wait(void);
+void start_barrier_destroy(void);
+
+/*
+ * CPU pinning and NUMA placement
+ *
+ * Without placement the scheduler migrates workers across cores (and NUMA
+ * nodes on multi-socket machines) mid-run, adding 20-30% run-to-run noise
+ * to the Part D curves. Both programs accept:
+ *   --pin compact         fill CPUs in ID order (worker i -> CPU i mod N)
+ *   --pin scatter         stride workers across the CPU ID space, which
+ *                         approximates spreading over sockets without
+ *                         needing topology discovery
+ *   --pin list:0,2,4      explicit CPU list, workers assigned round-robin
+ *   --numa local          MPOL_LOCAL: allocate on the node of the pinned CPU
+ *   --numa interleave     MPOL_INTERLEAVE across all memory nodes
+ * applied in each child after fork() / in each thread after creation.
+ */
+
+/* Maximum CPUs accepted in a --pin list: specification */
+#define PIN_MAX_CPUS 256
+
+#define PIN_MODE_NONE    0
+#define PIN_MODE_COMPACT 1
+#define PIN_MODE_SCATTER 2
+#define PIN_MODE_LIST    3
+
+typedef struct {
+    int mode;                   /* PIN_MODE_* */
+    int list_len;               /* entries in cpu_list for PIN_MODE_LIST */
+    int cpu_list[PIN_MAX_CPUS];
+} pin_policy_t;
+
+/*
+ * Parse a --pin specification (compact | scatter | list:0,2,4).
+ * Returns 0 on success, -1 on a malformed spec.
+ */
+int pin_policy_parse(pin_policy_t *policy, const char *spec);
+
+/*
+ * Pin the calling thread/process to the CPU the policy assigns to worker
+ * 'worker_index' of 'num_workers'. No-op for PIN_MODE_NONE.
+ * Returns the CPU pinned to, or -1 on failure.
+ */
+int pin_policy_apply(const pin_policy_t *policy, int worker_index,
+                     int num_workers);
+
+/*
+ * Apply a NUMA memory policy ("local" or "interleave") to the calling
+ * thread so subsequent allocations (worker_mem's buffers in particular)
+ * follow it. Returns 0 on success, -1 on failure or unknown mode.
+ */
+int numa_policy_apply(const char *mode);
+
+/*
+ * Mixed-workload duty cycle (worker type "mix")
+ *
+ * Real services are never purely cpu, mem, or io. A mix specification
+ * like "cpu:50,mem:30,io:20" turns one LOOP_COUNT iteration budget into
+ * an interleaved duty cycle: each 100-iteration round runs every phase
+ * for its weighted share, reusing the chunked worker bodies as phase
+ * kernels, so scheduler and page-cache interactions between phases show
+ * up the way they do in production. Weights are relative (they need not
+ * sum to 100); phase names are the chunk-capable workers: cpu,
+ * cpu-simd, mem, io.
+ */
+
+/* Maximum phases in one mix specification */
+#define MIX_MAX_PHASES 8
+
+/* Iterations per interleaving round, split across phases by weight */
+#define MIX_ROUND_ITERATIONS 100
+
+typedef struct {
+    int  num_phases;
+    long weights[MIX_MAX_PHASES];
+    char names[MIX_MAX_PHASES][16];
+} worker_mix_t;
+
+/*
+ * Parse a mix specification ("name:weight,name:weight,...").
+ * Returns 0 on success, -1 on malformed input or unknown phase names.
+ */
+int worker_mix_parse(worker_mix_t *mix, const char *spec);
+
+/*
+ * Run one full LOOP_COUNT budget as the mix's interleaved duty cycle.
+ */
+void worker_mix_run(const worker_mix_t *mix);
+
 /*
  * Helper function for memory worker (qsort comparison)
  */
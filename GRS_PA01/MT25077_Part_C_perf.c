@@ -0,0 +1,298 @@
+/*
+ * MT25077_Part_C_perf.c
+ *
+ * Implementation of the perf_event_open phase instrumentation
+ *
+ * Roll Number: MT25077
+ *
+ * One event group per thread: cycles is the leader, with instructions,
+ * LLC-misses, and dTLB-misses as siblings, all read atomically in one
+ * read() with PERF_FORMAT_GROUP so a phase delta is consistent across
+ * the four counters. All state is thread-local, so worker threads never
+ * contend on the instrumentation.
+ */
+
+#define _GNU_SOURCE
+
+#include "MT25077_Part_C_perf.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/* Counters in creation order; group reads return them in this order */
+#define PERF_NUM_EVENTS 4
+
+/* One phase's accumulated deltas */
+typedef struct {
+    const char *name;
+    long       calls;
+    long long  totals[PERF_NUM_EVENTS];
+} perf_phase_t;
+
+/* Group read layout for PERF_FORMAT_GROUP without ids */
+typedef struct {
+    long long nr;
+    long long values[PERF_NUM_EVENTS];
+} perf_group_reading_t;
+
+/* Per-thread instrumentation state */
+typedef struct {
+    int group_fd;                  /* leader fd, -1 when disabled */
+    int event_fds[PERF_NUM_EVENTS];
+    perf_phase_t phases[PERF_MAX_PHASES];
+    int num_phases;
+    const char *open_phase;        /* name passed to the pending begin */
+    perf_group_reading_t begin_reading;
+} perf_thread_state_t;
+
+static __thread perf_thread_state_t tls_perf = { .group_fd = -1 };
+
+static long sys_perf_event_open(struct perf_event_attr *attr, pid_t pid,
+                                int cpu, int group_fd, unsigned long flags) {
+    return syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+/* Event group descriptor: four events plus their report labels */
+typedef struct {
+    unsigned type;
+    unsigned long long config;
+} perf_event_desc_t;
+
+/* Preferred group: hardware counters for cycle/IPC/miss attribution */
+static const perf_event_desc_t perf_hw_events[PERF_NUM_EVENTS] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL
+                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB
+                          | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+static const char *perf_hw_labels[PERF_NUM_EVENTS] = {
+    "cycles", "instructions", "LLC-miss", "dTLB-miss"
+};
+
+/* Fallback group for hosts without a (virtualized) PMU: software events
+ * still give per-phase time and fault/switch attribution */
+static const perf_event_desc_t perf_sw_events[PERF_NUM_EVENTS] = {
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS },
+};
+static const char *perf_sw_labels[PERF_NUM_EVENTS] = {
+    "task-clock-ns", "page-faults", "ctx-switches", "migrations"
+};
+
+/* Labels of the group that actually opened, shared by report and CSV */
+static __thread const char **tls_perf_labels;
+static __thread int tls_perf_is_hw;
+
+/* Try to open one complete group; returns leader fd or -1 */
+static int perf_open_group(const perf_event_desc_t *events, int *fds) {
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].type;
+        attr.config = events[i].config;
+        attr.disabled = (i == 0);  /* group enabled through the leader */
+        attr.exclude_kernel = 1;   /* self-profiling under paranoid >= 1 */
+        attr.exclude_hv = 1;
+        if (i == 0) {
+            attr.read_format = PERF_FORMAT_GROUP;
+        }
+
+        fds[i] = (int)sys_perf_event_open(&attr, 0, -1,
+                                          i == 0 ? -1 : fds[0], 0);
+        if (fds[i] < 0) {
+            for (int j = 0; j < i; j++) {
+                close(fds[j]);
+            }
+            return -1;
+        }
+    }
+    return fds[0];
+}
+
+int perf_phase_thread_init(void) {
+    perf_thread_state_t *st = &tls_perf;
+
+    if (st->group_fd >= 0) {
+        return 0;  /* already initialized on this thread */
+    }
+
+    int fds[PERF_NUM_EVENTS];
+    if (perf_open_group(perf_hw_events, fds) >= 0) {
+        tls_perf_labels = perf_hw_labels;
+        tls_perf_is_hw = 1;
+    } else if (perf_open_group(perf_sw_events, fds) >= 0) {
+        fprintf(stderr, "perf hardware counters unavailable; using software "
+                        "events (task-clock, faults, switches)\n");
+        tls_perf_labels = perf_sw_labels;
+        tls_perf_is_hw = 0;
+    } else {
+        fprintf(stderr, "perf counters unavailable (%s); phase profiling "
+                        "disabled\n", strerror(errno));
+        return -1;
+    }
+
+    st->group_fd = fds[0];
+    memcpy(st->event_fds, fds, sizeof(fds));
+    st->num_phases = 0;
+    st->open_phase = NULL;
+
+    ioctl(st->group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(st->group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 0;
+}
+
+/* Read the whole group in one syscall; returns 0 on success */
+static int perf_read_group(perf_thread_state_t *st, perf_group_reading_t *out) {
+    ssize_t n = read(st->group_fd, out, sizeof(*out));
+    if (n < (ssize_t)sizeof(long long) || out->nr != PERF_NUM_EVENTS) {
+        return -1;
+    }
+    return 0;
+}
+
+void perf_phase_begin(const char *phase_name) {
+    perf_thread_state_t *st = &tls_perf;
+    if (st->group_fd < 0) {
+        return;
+    }
+    st->open_phase = phase_name;
+    if (perf_read_group(st, &st->begin_reading) != 0) {
+        st->open_phase = NULL;
+    }
+}
+
+void perf_phase_end(void) {
+    perf_thread_state_t *st = &tls_perf;
+    if (st->group_fd < 0 || st->open_phase == NULL) {
+        return;
+    }
+
+    perf_group_reading_t now;
+    if (perf_read_group(st, &now) != 0) {
+        st->open_phase = NULL;
+        return;
+    }
+
+    /* Find or create the slot for this phase name */
+    perf_phase_t *phase = NULL;
+    for (int i = 0; i < st->num_phases; i++) {
+        if (strcmp(st->phases[i].name, st->open_phase) == 0) {
+            phase = &st->phases[i];
+            break;
+        }
+    }
+    if (phase == NULL) {
+        if (st->num_phases >= PERF_MAX_PHASES) {
+            st->open_phase = NULL;
+            return;  /* table full: drop silently rather than corrupt */
+        }
+        phase = &st->phases[st->num_phases++];
+        phase->name = st->open_phase;
+        phase->calls = 0;
+        memset(phase->totals, 0, sizeof(phase->totals));
+    }
+
+    phase->calls++;
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        phase->totals[i] += now.values[i] - st->begin_reading.values[i];
+    }
+    st->open_phase = NULL;
+}
+
+void perf_phase_report(const char *worker_type) {
+    perf_thread_state_t *st = &tls_perf;
+    if (st->group_fd < 0 || st->num_phases == 0) {
+        return;
+    }
+
+    printf("  perf phases (%s):\n", worker_type);
+    printf("    %-14s %10s %14s %14s %12s %12s %6s\n",
+           "phase", "calls", tls_perf_labels[0], tls_perf_labels[1],
+           tls_perf_labels[2], tls_perf_labels[3],
+           tls_perf_is_hw ? "IPC" : "-");
+    for (int i = 0; i < st->num_phases; i++) {
+        const perf_phase_t *p = &st->phases[i];
+        double ipc = (tls_perf_is_hw && p->totals[0] > 0)
+                         ? (double)p->totals[1] / (double)p->totals[0]
+                         : 0.0;
+        printf("    %-14s %10ld %14lld %14lld %12lld %12lld %6.2f\n",
+               p->name, p->calls, p->totals[0], p->totals[1],
+               p->totals[2], p->totals[3], ipc);
+    }
+    fflush(stdout);
+}
+
+int perf_phase_csv_append(const char *csv_path, const char *program,
+                          const char *worker_type) {
+    perf_thread_state_t *st = &tls_perf;
+    if (st->group_fd < 0 || st->num_phases == 0) {
+        return 0;  /* nothing to write is not a failure */
+    }
+
+    /* Header only on creation, same convention as the measure module */
+    int fd = open(csv_path, O_WRONLY | O_CREAT | O_APPEND | O_EXCL, 0644);
+    int fresh = (fd >= 0);
+    if (fd < 0) {
+        if (errno != EEXIST) {
+            fprintf(stderr, "Failed to open %s: %s\n", csv_path, strerror(errno));
+            return -1;
+        }
+        fd = open(csv_path, O_WRONLY | O_APPEND);
+        if (fd < 0) {
+            fprintf(stderr, "Failed to open %s: %s\n", csv_path, strerror(errno));
+            return -1;
+        }
+    }
+
+    char buf[PERF_MAX_PHASES * 128 + 80];
+    int len = 0;
+    if (fresh) {
+        len += snprintf(buf + len, sizeof(buf) - (size_t)len,
+                        "Program,Function,Phase,Calls,%s,%s,%s,%s\n",
+                        tls_perf_labels[0], tls_perf_labels[1],
+                        tls_perf_labels[2], tls_perf_labels[3]);
+    }
+    for (int i = 0; i < st->num_phases; i++) {
+        const perf_phase_t *p = &st->phases[i];
+        len += snprintf(buf + len, sizeof(buf) - (size_t)len,
+                        "%s,%s,%s,%ld,%lld,%lld,%lld,%lld\n",
+                        program, worker_type, p->name, p->calls,
+                        p->totals[0], p->totals[1], p->totals[2], p->totals[3]);
+    }
+
+    int ret = 0;
+    if (write(fd, buf, (size_t)len) != (ssize_t)len) {
+        fprintf(stderr, "Failed to append to %s: %s\n", csv_path, strerror(errno));
+        ret = -1;
+    }
+    close(fd);
+    return ret;
+}
+
+void perf_phase_thread_shutdown(void) {
+    perf_thread_state_t *st = &tls_perf;
+    if (st->group_fd < 0) {
+        return;
+    }
+    ioctl(st->group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < PERF_NUM_EVENTS; i++) {
+        close(st->event_fds[i]);
+    }
+    st->group_fd = -1;
+    st->num_phases = 0;
+    st->open_phase = NULL;
+}
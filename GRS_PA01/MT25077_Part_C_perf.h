@@ -0,0 +1,67 @@
+/*
+ * MT25077_Part_C_perf.h
+ *
+ * perf_event_open phase instrumentation for the worker functions
+ *
+ * Roll Number: MT25077
+ *
+ * The Part C script shells out to `perf stat` and only sees whole-process
+ * counters, so a regression in the aggregate numbers cannot be attributed
+ * to the phase that moved (fill vs. scan vs. sort vs. memcpy inside
+ * worker_mem(), or the inner loop of worker_cpu()). This library opens one
+ * perf event group per worker thread - cycles (leader), instructions,
+ * LLC-misses, and dTLB-misses - and lets the workers bracket their phases
+ * with begin/end markers. Counter deltas accumulate per phase name, and
+ * the harness dumps a per-phase table (and optionally CSV rows) when the
+ * worker finishes.
+ *
+ * The markers are no-ops on threads that never called
+ * perf_phase_thread_init(), so instrumented workers run unchanged when
+ * profiling is off, and the library degrades gracefully where
+ * perf_event_open is unavailable (perf_event_paranoid, missing PMU).
+ */
+
+#ifndef MT25077_PART_C_PERF_H
+#define MT25077_PART_C_PERF_H
+
+#include <stddef.h>
+
+/* Maximum distinct phase names tracked per thread */
+#define PERF_MAX_PHASES 16
+
+/*
+ * Open the per-thread counter group. Returns 0 on success, -1 when perf
+ * events are unavailable (a notice is printed once; markers then no-op).
+ */
+int perf_phase_thread_init(void);
+
+/*
+ * Bracket a phase. Phases may repeat (per loop iteration); deltas
+ * accumulate under the same name. Nesting is not supported: a begin
+ * while another phase is open abandons the open phase (its interval is
+ * dropped, not accumulated), so keep markers flat.
+ */
+void perf_phase_begin(const char *phase_name);
+void perf_phase_end(void);
+
+/*
+ * Print the per-phase table for this thread in the programs' indented
+ * console style, labeled with the worker type.
+ */
+void perf_phase_report(const char *worker_type);
+
+/*
+ * Append this thread's phases as CSV rows:
+ *     Program,Function,Phase,Calls,Cycles,Instructions,LLCMisses,dTLBMisses
+ * creating the file with a header first when needed.
+ * Returns 0 on success, -1 on I/O failure.
+ */
+int perf_phase_csv_append(const char *csv_path, const char *program,
+                          const char *worker_type);
+
+/*
+ * Close the counter fds and reset this thread's phase table.
+ */
+void perf_phase_thread_shutdown(void);
+
+#endif /* MT25077_PART_C_PERF_H */
@@ -0,0 +1,134 @@
+/*
+ * MT25077_Part_D_measure.c
+ *
+ * Implementation of the in-process measurement engine
+ *
+ * Roll Number: MT25077
+ *
+ * See MT25077_Part_D_measure.h for the design rationale. Everything here
+ * is plain getrusage/clock_gettime arithmetic; the only file I/O is the
+ * O_APPEND CSV writer, which emits the same schema the Part D shell
+ * pipeline produced.
+ */
+
+#define _GNU_SOURCE  /* for RUSAGE_THREAD */
+
+#include "MT25077_Part_D_measure.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+/* Convert a struct timeval from rusage into seconds */
+static double tv_to_s(const struct timeval *tv) {
+    return (double)tv->tv_sec + (double)tv->tv_usec / 1e6;
+}
+
+void measure_begin(measure_sample_t *sample) {
+    memset(sample, 0, sizeof(*sample));
+    clock_gettime(CLOCK_MONOTONIC, &sample->wall_start);
+}
+
+/* Shared by both end paths: wall delta plus rusage-derived counters */
+void measure_end_rusage(measure_sample_t *sample, const struct rusage *ru) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample->wall_s = (double)(now.tv_sec - sample->wall_start.tv_sec)
+                     + (double)(now.tv_nsec - sample->wall_start.tv_nsec) / 1e9;
+
+    sample->utime_s    = tv_to_s(&ru->ru_utime);
+    sample->stime_s    = tv_to_s(&ru->ru_stime);
+    sample->max_rss_kb = ru->ru_maxrss;
+    sample->minflt     = ru->ru_minflt;
+    sample->majflt     = ru->ru_majflt;
+    sample->inblock    = ru->ru_inblock;
+    sample->oublock    = ru->ru_oublock;
+    sample->nvcsw      = ru->ru_nvcsw;
+    sample->nivcsw     = ru->ru_nivcsw;
+}
+
+double measure_wall_elapsed(const measure_sample_t *sample) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - sample->wall_start.tv_sec)
+           + (double)(now.tv_nsec - sample->wall_start.tv_nsec) / 1e9;
+}
+
+void measure_end_thread(measure_sample_t *sample) {
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    measure_end_rusage(sample, &ru);
+}
+
+void measure_accumulate(measure_sample_t *total, const measure_sample_t *part) {
+    total->utime_s += part->utime_s;
+    total->stime_s += part->stime_s;
+    total->minflt  += part->minflt;
+    total->majflt  += part->majflt;
+    total->inblock += part->inblock;
+    total->oublock += part->oublock;
+    total->nvcsw   += part->nvcsw;
+    total->nivcsw  += part->nivcsw;
+    if (part->max_rss_kb > total->max_rss_kb) {
+        total->max_rss_kb = part->max_rss_kb;
+    }
+}
+
+void measure_print(const measure_sample_t *sample, const char *label) {
+    printf("  %s: wall %.3f s, user %.3f s, sys %.3f s, maxrss %ld KB\n",
+           label, sample->wall_s, sample->utime_s, sample->stime_s,
+           sample->max_rss_kb);
+    printf("  %s: faults %ld minor / %ld major, ctx switches %ld vol / %ld invol\n",
+           label, sample->minflt, sample->majflt,
+           sample->nvcsw, sample->nivcsw);
+}
+
+int measure_csv_append(const char *csv_path, const char *program,
+                       const char *worker_type, int num_workers,
+                       const measure_sample_t *sample) {
+    /* Write the header only when creating the file */
+    int fd = open(csv_path, O_WRONLY | O_CREAT | O_APPEND | O_EXCL, 0644);
+    int fresh = (fd >= 0);
+    if (fd < 0) {
+        if (errno != EEXIST) {
+            fprintf(stderr, "Failed to open %s: %s\n", csv_path, strerror(errno));
+            return -1;
+        }
+        fd = open(csv_path, O_WRONLY | O_APPEND);
+        if (fd < 0) {
+            fprintf(stderr, "Failed to open %s: %s\n", csv_path, strerror(errno));
+            return -1;
+        }
+    }
+
+    /* Same derived metrics the shell pipeline reported:
+     * CPU% over the whole run, rusage block counts as I/O rate */
+    double cpu_pct = 0.0;
+    double io_kbs = 0.0;
+    if (sample->wall_s > 0.0) {
+        cpu_pct = (sample->utime_s + sample->stime_s) / sample->wall_s * 100.0;
+        io_kbs = (double)(sample->inblock + sample->oublock) * 0.5
+                 / sample->wall_s;
+    }
+
+    char line[256];
+    int len = 0;
+    if (fresh) {
+        len += snprintf(line + len, sizeof(line) - (size_t)len,
+                        "Program,Function,Workers,CPU%%,Memory(KB),IO(KB/s),Time(s)\n");
+    }
+    len += snprintf(line + len, sizeof(line) - (size_t)len,
+                    "%s,%s,%d,%.0f,%ld,%.4f,%.2f\n",
+                    program, worker_type, num_workers,
+                    cpu_pct, sample->max_rss_kb, io_kbs, sample->wall_s);
+
+    int ret = 0;
+    if (write(fd, line, (size_t)len) != (ssize_t)len) {
+        fprintf(stderr, "Failed to append to %s: %s\n", csv_path, strerror(errno));
+        ret = -1;
+    }
+    close(fd);
+    return ret;
+}
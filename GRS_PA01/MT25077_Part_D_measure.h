@@ -0,0 +1,89 @@
+/*
+ * MT25077_Part_D_measure.h
+ *
+ * In-process measurement engine for Program A and Program B
+ *
+ * Roll Number: MT25077
+ *
+ * The Part C/D shell scripts wrap every run in /usr/bin/time and external
+ * tools, paying a fork/exec per sample and only seeing whole-process
+ * numbers. This engine collects the same metrics in-process - wall time,
+ * user/system CPU time, max RSS, minor/major faults, and voluntary/
+ * involuntary context switches - per child (via wait4) or per thread (via
+ * RUSAGE_THREAD), and appends rows in the exact schema of
+ * MT25077_Part_D_CSV.csv:
+ *
+ *     Program,Function,Workers,CPU%,Memory(KB),IO(KB/s),Time(s)
+ *
+ * so the existing plot script keeps working while a sweep's per-sample
+ * cost drops from seconds of tool startup to microseconds.
+ */
+
+#ifndef MT25077_PART_D_MEASURE_H
+#define MT25077_PART_D_MEASURE_H
+
+#include <sys/resource.h>
+#include <time.h>
+
+/* One measured interval: snapshot at begin, deltas filled in at end */
+typedef struct {
+    struct timespec wall_start;
+    double wall_s;        /* wall-clock seconds for the interval */
+    double utime_s;       /* user CPU seconds */
+    double stime_s;       /* system CPU seconds */
+    long   max_rss_kb;    /* peak resident set size, KB */
+    long   minflt;        /* minor page faults */
+    long   majflt;        /* major page faults */
+    long   inblock;       /* 512-byte blocks read from storage */
+    long   oublock;       /* 512-byte blocks written to storage */
+    long   nvcsw;         /* voluntary context switches */
+    long   nivcsw;        /* involuntary context switches */
+} measure_sample_t;
+
+/*
+ * Start an interval: records the wall clock. CPU/memory numbers come from
+ * the rusage source chosen at measure_end_*() time, which is already a
+ * since-start accumulation for children and threads.
+ */
+void measure_begin(measure_sample_t *sample);
+
+/*
+ * Finish an interval using the calling thread's own counters
+ * (RUSAGE_THREAD). Used by Program B's worker threads.
+ */
+void measure_end_thread(measure_sample_t *sample);
+
+/*
+ * Fill a sample from an rusage already obtained elsewhere, e.g. the
+ * per-child rusage returned by wait4() in Program A.
+ */
+void measure_end_rusage(measure_sample_t *sample, const struct rusage *ru);
+
+/*
+ * Accumulate 'part' into 'total': CPU times, faults, blocks, and context
+ * switches are summed; max RSS takes the maximum. Wall time is left to
+ * the caller (it is a property of the whole run, not a sum).
+ */
+void measure_accumulate(measure_sample_t *total, const measure_sample_t *part);
+
+/*
+ * Print one worker's numbers in the programs' indented console style.
+ */
+void measure_print(const measure_sample_t *sample, const char *label);
+
+/*
+ * Seconds elapsed since measure_begin() on this sample, without touching
+ * its counters. Used for the whole-run wall time of an aggregate.
+ */
+double measure_wall_elapsed(const measure_sample_t *sample);
+
+/*
+ * Append one row in the MT25077_Part_D_CSV.csv schema, creating the file
+ * with its header line first if needed. 'program' is "a" or "b".
+ * Returns 0 on success, -1 on I/O failure.
+ */
+int measure_csv_append(const char *csv_path, const char *program,
+                       const char *worker_type, int num_workers,
+                       const measure_sample_t *sample);
+
+#endif /* MT25077_PART_D_MEASURE_H */
@@ -0,0 +1,232 @@
+/*
+ * MT25077_Part_D_results.c
+ *
+ * Implementation of the binary streaming result format
+ *
+ * Roll Number: MT25077
+ *
+ * See the header for the file layout and crash-safety argument. The
+ * mapping is grown by capacity doubling (ftruncate + remap) so appends
+ * stay O(1) amortized, and each append queues write-back for just the
+ * touched range with msync(MS_ASYNC).
+ */
+
+#define _GNU_SOURCE
+
+#include "MT25077_Part_D_results.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Initial capacity: header plus this many records */
+#define RESULTS_INITIAL_CAPACITY 64
+
+/* Size needed for 'capacity' records */
+static size_t results_size_for(unsigned long long capacity) {
+    return sizeof(results_header_t)
+           + (size_t)capacity * sizeof(results_record_t);
+}
+
+/* Map (or remap) the file at the given size */
+static int results_map(results_writer_t *writer, size_t size) {
+    if (ftruncate(writer->fd, (off_t)size) != 0) {
+        fprintf(stderr, "ftruncate of results file failed: %s\n",
+                strerror(errno));
+        return -1;
+    }
+
+    char *map = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, writer->fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "mmap of results file failed: %s\n", strerror(errno));
+        return -1;
+    }
+
+    if (writer->map != NULL) {
+        munmap(writer->map, writer->map_size);
+    }
+    writer->map = map;
+    writer->map_size = size;
+    writer->header = (results_header_t *)map;
+    return 0;
+}
+
+int results_open(results_writer_t *writer, const char *path) {
+    memset(writer, 0, sizeof(*writer));
+
+    writer->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (writer->fd < 0) {
+        fprintf(stderr, "Failed to open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    /* Serialize whole open-append-close sessions across processes so two
+     * programs sharing one results file never race on record_count */
+    if (flock(writer->fd, LOCK_EX) != 0) {
+        fprintf(stderr, "flock of results file failed: %s\n", strerror(errno));
+        close(writer->fd);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(writer->fd, &st) != 0) {
+        close(writer->fd);
+        return -1;
+    }
+
+    if (st.st_size == 0) {
+        /* Fresh file: write the header into an initial-capacity mapping */
+        if (results_map(writer, results_size_for(RESULTS_INITIAL_CAPACITY)) != 0) {
+            close(writer->fd);
+            return -1;
+        }
+        writer->header->magic = RESULTS_MAGIC;
+        writer->header->version = RESULTS_VERSION;
+        writer->header->record_count = 0;
+        msync(writer->map, sizeof(results_header_t), MS_ASYNC);
+        return 0;
+    }
+
+    if ((size_t)st.st_size < sizeof(results_header_t)) {
+        fprintf(stderr, "%s is not a results file (too short)\n", path);
+        close(writer->fd);
+        return -1;
+    }
+    if (results_map(writer, (size_t)st.st_size) != 0) {
+        close(writer->fd);
+        return -1;
+    }
+    if (writer->header->magic != RESULTS_MAGIC
+        || writer->header->version != RESULTS_VERSION) {
+        fprintf(stderr, "%s has wrong magic/version (magic 0x%x, version %u)\n",
+                path, writer->header->magic, writer->header->version);
+        results_close(writer);
+        return -1;
+    }
+    return 0;
+}
+
+int results_append(results_writer_t *writer, const char *program,
+                   const char *worker_type, int num_workers,
+                   const measure_sample_t *sample) {
+    unsigned long long count = writer->header->record_count;
+
+    /* Grow by doubling when the committed records fill the mapping */
+    if (results_size_for(count + 1) > writer->map_size) {
+        unsigned long long capacity =
+            (writer->map_size - sizeof(results_header_t))
+            / sizeof(results_record_t);
+        if (results_map(writer, results_size_for(capacity * 2)) != 0) {
+            return -1;
+        }
+    }
+
+    results_record_t *rec = (results_record_t *)
+        (writer->map + results_size_for(count));
+    memset(rec, 0, sizeof(*rec));
+    snprintf(rec->program, sizeof(rec->program), "%s", program);
+    snprintf(rec->worker, sizeof(rec->worker), "%s", worker_type);
+    rec->num_workers = num_workers;
+    rec->max_rss_kb = sample->max_rss_kb;
+    rec->wall_s = sample->wall_s;
+    if (sample->wall_s > 0.0) {
+        rec->cpu_pct = (sample->utime_s + sample->stime_s)
+                       / sample->wall_s * 100.0;
+        rec->io_kbs = (double)(sample->inblock + sample->oublock) * 0.5
+                      / sample->wall_s;
+    }
+
+    /* Commit order: record first, then the count that makes it visible */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    writer->header->record_count = count + 1;
+
+    /* Queue write-back for the touched record and the header */
+    msync(writer->map + results_size_for(count), sizeof(*rec), MS_ASYNC);
+    msync(writer->map, sizeof(results_header_t), MS_ASYNC);
+    return 0;
+}
+
+void results_close(results_writer_t *writer) {
+    if (writer->map != NULL) {
+        msync(writer->map, writer->map_size, MS_SYNC);
+        munmap(writer->map, writer->map_size);
+        writer->map = NULL;
+    }
+    if (writer->fd >= 0) {
+        close(writer->fd);
+        writer->fd = -1;
+    }
+}
+
+int results_to_csv(const char *bin_path, const char *csv_path) {
+    int fd = open(bin_path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to open %s: %s\n", bin_path, strerror(errno));
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(results_header_t)) {
+        fprintf(stderr, "%s is not a results file\n", bin_path);
+        close(fd);
+        return -1;
+    }
+
+    char *map = (char *)mmap(NULL, (size_t)st.st_size, PROT_READ,
+                             MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "mmap of %s failed: %s\n", bin_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+
+    const results_header_t *header = (const results_header_t *)map;
+    if (header->magic != RESULTS_MAGIC || header->version != RESULTS_VERSION) {
+        fprintf(stderr, "%s has wrong magic/version\n", bin_path);
+        munmap(map, (size_t)st.st_size);
+        close(fd);
+        return -1;
+    }
+
+    /* Never read past the file even if the count is damaged */
+    unsigned long long count = header->record_count;
+    unsigned long long max_count =
+        ((size_t)st.st_size - sizeof(results_header_t))
+        / sizeof(results_record_t);
+    if (count > max_count) {
+        fprintf(stderr, "Warning: %s count %llu exceeds file size; "
+                "converting %llu records\n", bin_path, count, max_count);
+        count = max_count;
+    }
+
+    FILE *out = fopen(csv_path, "w");
+    if (out == NULL) {
+        fprintf(stderr, "Failed to open %s: %s\n", csv_path, strerror(errno));
+        munmap(map, (size_t)st.st_size);
+        close(fd);
+        return -1;
+    }
+
+    fprintf(out, "Program,Function,Workers,CPU%%,Memory(KB),IO(KB/s),Time(s)\n");
+    const results_record_t *records =
+        (const results_record_t *)(map + sizeof(results_header_t));
+    for (unsigned long long i = 0; i < count; i++) {
+        const results_record_t *rec = &records[i];
+        fprintf(out, "%s,%s,%d,%.0f,%ld,%.4f,%.2f\n",
+                rec->program, rec->worker, rec->num_workers,
+                rec->cpu_pct, rec->max_rss_kb, rec->io_kbs, rec->wall_s);
+    }
+
+    fclose(out);
+    munmap(map, (size_t)st.st_size);
+    close(fd);
+    printf("Converted %llu records from %s to %s\n", count, bin_path, csv_path);
+    return 0;
+}
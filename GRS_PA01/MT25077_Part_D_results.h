@@ -0,0 +1,89 @@
+/*
+ * MT25077_Part_D_results.h
+ *
+ * Binary streaming result format with an mmap append writer
+ *
+ * Roll Number: MT25077
+ *
+ * The Part D shell pipeline appends text rows via shell redirection: a
+ * crash loses the partial run, every row costs process startup, and the
+ * plot script re-parses the whole text file each time. This module stores
+ * results as fixed-width binary records in an mmap'd, append-only file:
+ *
+ *   [results_header_t][record 0][record 1]...
+ *
+ * The header carries a magic, a schema version, and the committed record
+ * count. An append memcpy's the record into the mapping first and only
+ * then increments the committed count, so a crash mid-append leaves a
+ * file whose committed records are all intact - the torn tail simply is
+ * not counted. Appends are O(1); the file grows in capacity doublings.
+ *
+ * results_to_csv() converts a binary file into the exact
+ * Program,Function,Workers,CPU%,Memory(KB),IO(KB/s),Time(s) schema so
+ * MT25077_Part_D_plot.py keeps working unchanged.
+ */
+
+#ifndef MT25077_PART_D_RESULTS_H
+#define MT25077_PART_D_RESULTS_H
+
+#include <stddef.h>
+
+#include "MT25077_Part_D_measure.h"
+
+/* "MTRS" little-endian */
+#define RESULTS_MAGIC   0x5352544dU
+#define RESULTS_VERSION 1U
+
+/* File header; record_count is the number of committed records */
+typedef struct {
+    unsigned int       magic;
+    unsigned int       version;
+    unsigned long long record_count;
+} results_header_t;
+
+/* One fixed-width result record, mirroring the Part D CSV columns */
+typedef struct {
+    char   program[4];     /* "a" or "b", NUL-padded */
+    char   worker[16];     /* worker type name, NUL-padded */
+    int    num_workers;
+    double cpu_pct;
+    long   max_rss_kb;
+    double io_kbs;
+    double wall_s;
+} results_record_t;
+
+/* Writer state: the whole file stays mapped between appends */
+typedef struct {
+    int                fd;
+    char              *map;       /* header + records */
+    size_t             map_size;  /* mapped/ftruncated size */
+    results_header_t  *header;    /* points into the mapping */
+} results_writer_t;
+
+/*
+ * Open (or create) a binary results file for appending. Validates the
+ * header of an existing file. Returns 0 on success, -1 on failure.
+ */
+int results_open(results_writer_t *writer, const char *path);
+
+/*
+ * Append one committed record derived from a measurement sample.
+ * Returns 0 on success, -1 on failure.
+ */
+int results_append(results_writer_t *writer, const char *program,
+                   const char *worker_type, int num_workers,
+                   const measure_sample_t *sample);
+
+/*
+ * Unmap and close the writer. The file is valid at every point before,
+ * during, and after this call.
+ */
+void results_close(results_writer_t *writer);
+
+/*
+ * Convert a binary results file to CSV in the MT25077_Part_D_CSV.csv
+ * schema (header line included). Returns 0 on success, -1 on failure.
+ */
+int results_to_csv(const char *bin_path, const char *csv_path);
+
+#endif /* MT25077_PART_D_RESULTS_H */
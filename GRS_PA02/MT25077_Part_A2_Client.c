@@ -6,6 +6,12 @@ static void *client_thread_fn(void *arg) {
     struct client_thread_args *cta = (struct client_thread_args *)arg;
     int msg_size = cta->msg_size;
 
+    /* Multi-connection mode: hundreds of sockets per thread via epoll */
+    if (cta->mc_conns > 0) {
+        client_multi_conn_run(cta);
+        return NULL;
+    }
+
     int sock = connect_to_server(cta->server_ip, cta->port);
     if (sock < 0) return NULL;
 
@@ -16,6 +22,30 @@ static void *client_thread_fn(void *arg) {
         return NULL;
     }
 
+    /* Scatter-gather mode: 8 per-field buffers matching the server's
+     * message layout, so the receive side of the copy comparison is
+     * instrumented too instead of collapsing into one flat buffer */
+    int field_size = msg_size / NUM_FIELDS;
+    struct message *sg_msg = NULL;
+    if (cta->sg_mode) {
+        sg_msg = alloc_message(msg_size);
+        if (!sg_msg) {
+            free(recv_buf);
+            close(sock);
+            return NULL;
+        }
+    }
+
+    if (cta->ts_mode && ts_enable(sock) != 0) {
+        perror("setsockopt SO_TIMESTAMPING");
+        fprintf(stderr, "  Thread %d: timestamping unavailable\n",
+                cta->thread_id);
+        cta->ts_mode = 0;
+    }
+
+    struct timespec cpu_t0, cpu_t1;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_t0);
+
     double start_time = get_time_us();
     double end_time   = start_time + (double)cta->duration * 1e6;
     double total_latency = 0.0;
@@ -25,17 +55,77 @@ static void *client_thread_fn(void *arg) {
     while (get_time_us() < end_time) {
         double msg_start = get_time_us();
 
-        ssize_t ret = recv_all(sock, recv_buf, msg_size);
+        ssize_t ret;
+        if (cta->sg_mode) {
+            /* Fresh iovecs each message: recv_all_vec consumes them */
+            struct iovec iov[NUM_FIELDS];
+            for (int i = 0; i < NUM_FIELDS; i++) {
+                iov[i].iov_base = sg_msg->fields[i];
+                iov[i].iov_len  = (size_t)field_size;
+            }
+            ret = recv_all_vec(sock, iov, NUM_FIELDS, (size_t)msg_size);
+            if (ret > 0) {
+                /* Verify the field patterns in place */
+                for (int i = 0; i < NUM_FIELDS; i++) {
+                    const char *p = sg_msg->fields[i];
+                    for (int j = 0; j < field_size; j++) {
+                        if (p[j] != 'A' + i) {
+                            cta->verify_errors++;
+                            break;
+                        }
+                    }
+                }
+            }
+        } else if (cta->ts_mode) {
+            /* recvmsg so every chunk carries its kernel RX timestamp */
+            size_t got = 0;
+            ret = 0;
+            while (got < (size_t)msg_size) {
+                char cbuf[256];
+                struct iovec iov = { recv_buf + got, (size_t)msg_size - got };
+                struct msghdr mh;
+                memset(&mh, 0, sizeof(mh));
+                mh.msg_iov        = &iov;
+                mh.msg_iovlen     = 1;
+                mh.msg_control    = cbuf;
+                mh.msg_controllen = sizeof(cbuf);
+
+                ssize_t n = recvmsg(sock, &mh, 0);
+                if (n <= 0) {
+                    ret = n;
+                    break;
+                }
+                got += (size_t)n;
+                ret = (ssize_t)got;
+
+                int has_hw = 0;
+                double delta = ts_extract_delta_us(&mh, &has_hw);
+                if (delta >= 0.0) {
+                    lat_hist_record(&cta->ts_hist, delta);
+                    cta->ts_samples++;
+                }
+                if (has_hw) {
+                    cta->hw_samples++;
+                }
+            }
+        } else {
+            ret = recv_all(sock, recv_buf, msg_size);
+        }
         if (ret <= 0) break;
 
         double msg_end = get_time_us();
         total_latency += (msg_end - msg_start);
+        lat_hist_record(&cta->hist, msg_end - msg_start);
         bytes += msg_size;
         msgs++;
     }
 
     double elapsed_s = (get_time_us() - start_time) / 1e6;
 
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_t1);
+    cta->cpu_time_s = (double)(cpu_t1.tv_sec - cpu_t0.tv_sec)
+                      + (double)(cpu_t1.tv_nsec - cpu_t0.tv_nsec) / 1e9;
+
     cta->bytes_received    = bytes;
     cta->messages_received = msgs;
     cta->total_latency_us  = total_latency;
@@ -46,6 +136,15 @@ static void *client_thread_fn(void *arg) {
             (bytes * 8.0) / (elapsed_s * 1e9),
             msgs > 0 ? total_latency / msgs : 0.0);
 
+    if (cta->sg_mode && bytes > 0) {
+        fprintf(stderr, "  Thread %d: sg receive %.3f CPU ns/byte, "
+                "%lld verify errors\n",
+                cta->thread_id,
+                cta->cpu_time_s * 1e9 / (double)bytes,
+                cta->verify_errors);
+    }
+
+    free_message(sg_msg);
     free(recv_buf);
     close(sock);
     return NULL;
@@ -55,7 +154,46 @@ int main(int argc, char *argv[]) {
     if (argc < 5) {
         fprintf(stderr,
                 "Usage: %s <server_ip> <port> <msg_size> <thread_count> "
-                "[duration_s]\n", argv[0]);
+                "[duration_s] [--sg|--ts] [--conns N [--rate R]]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* Optional trailing flags: --sg (scatter receive), --ts (timestamping) */
+    int sg_mode = 0;
+    int ts_mode = 0;
+    int mc_conns = 0;
+    long mc_rate = 0;
+    while (argc > 2) {
+        if (strcmp(argv[argc - 1], "--sg") == 0) {
+            sg_mode = 1;
+            argc--;
+        } else if (strcmp(argv[argc - 1], "--ts") == 0) {
+            ts_mode = 1;
+            argc--;
+        } else if (strcmp(argv[argc - 2], "--conns") == 0) {
+            mc_conns = atoi(argv[argc - 1]);
+            if (mc_conns < 1) {
+                fprintf(stderr, "Error: --conns requires a count >= 1\n");
+                return EXIT_FAILURE;
+            }
+            argc -= 2;
+        } else if (strcmp(argv[argc - 2], "--rate") == 0) {
+            mc_rate = atol(argv[argc - 1]);
+            if (mc_rate < 1) {
+                fprintf(stderr, "Error: --rate requires msgs/sec >= 1\n");
+                return EXIT_FAILURE;
+            }
+            argc -= 2;
+        } else {
+            break;
+        }
+    }
+    if (mc_conns > 0 && (sg_mode || ts_mode)) {
+        fprintf(stderr, "Error: --conns cannot combine with --sg/--ts\n");
+        return EXIT_FAILURE;
+    }
+    if (sg_mode && ts_mode) {
+        fprintf(stderr, "Error: --sg and --ts are mutually exclusive\n");
         return EXIT_FAILURE;
     }
 
@@ -85,17 +223,24 @@ int main(int argc, char *argv[]) {
         args[i].msg_size  = msg_size;
         args[i].duration  = duration;
         args[i].thread_id = i;
+        args[i].sg_mode   = sg_mode;
+        args[i].ts_mode   = ts_mode;
+        args[i].mc_conns  = mc_conns;
+        args[i].mc_rate   = mc_rate;
         pthread_create(&threads[i], NULL, client_thread_fn, &args[i]);
     }
 
     long long total_bytes = 0, total_msgs = 0;
     double total_latency = 0.0;
+    struct lat_hist merged;
+    memset(&merged, 0, sizeof(merged));
 
     for (int i = 0; i < thread_count; i++) {
         pthread_join(threads[i], NULL);
         total_bytes   += args[i].bytes_received;
         total_msgs    += args[i].messages_received;
         total_latency += args[i].total_latency_us;
+        lat_hist_merge(&merged, &args[i].hist);
     }
 
     double throughput_gbps = (total_bytes * 8.0) / ((double)duration * 1e9);
@@ -108,11 +253,50 @@ int main(int argc, char *argv[]) {
     fprintf(stderr, "Total msgs:   %lld\n", total_msgs);
     fprintf(stderr, "Throughput:   %.4f Gbps\n", throughput_gbps);
     fprintf(stderr, "Avg latency:  %.2f us\n", avg_latency_us);
+    if (ts_mode) {
+        struct lat_hist ts_merged;
+        memset(&ts_merged, 0, sizeof(ts_merged));
+        long long ts_samples = 0, hw_samples = 0;
+        for (int i = 0; i < thread_count; i++) {
+            lat_hist_merge(&ts_merged, &args[i].ts_hist);
+            ts_samples += args[i].ts_samples;
+            hw_samples += args[i].hw_samples;
+        }
+        fprintf(stderr, "Kernel->app delta: p50=%.0f p99=%.0f max=%.0f us "
+                "(%lld sw samples; %lld carried NIC hardware stamps, "
+                "kept out of the histogram)\n",
+                lat_hist_percentile(&ts_merged, 50.0),
+                lat_hist_percentile(&ts_merged, 99.0),
+                ts_merged.max_us, ts_samples, hw_samples);
+    }
+    if (sg_mode) {
+        double cpu_s = 0.0;
+        long long verify_errors = 0;
+        for (int i = 0; i < thread_count; i++) {
+            cpu_s += args[i].cpu_time_s;
+            verify_errors += args[i].verify_errors;
+        }
+        fprintf(stderr, "SG receive:   %.3f CPU ns/byte, %lld verify errors\n",
+                total_bytes > 0 ? cpu_s * 1e9 / (double)total_bytes : 0.0,
+                verify_errors);
+    }
+    fprintf(stderr, "Latency percentiles: p50=%.0f p90=%.0f p99=%.0f "
+            "p99.9=%.0f max=%.0f us\n",
+            lat_hist_percentile(&merged, 50.0),
+            lat_hist_percentile(&merged, 90.0),
+            lat_hist_percentile(&merged, 99.0),
+            lat_hist_percentile(&merged, 99.9),
+            merged.max_us);
 
     /* Machine-parseable CSV line to stdout for experiment script */
-    printf("RESULT,one_copy,%d,%d,%.4f,%.2f,%lld,%lld\n",
+    printf("RESULT,one_copy,%d,%d,%.4f,%.2f,%lld,%lld,%.0f,%.0f,%.0f,%.0f,%.0f\n",
            msg_size, thread_count, throughput_gbps, avg_latency_us,
-           total_bytes, total_msgs);
+           total_bytes, total_msgs,
+           lat_hist_percentile(&merged, 50.0),
+           lat_hist_percentile(&merged, 90.0),
+           lat_hist_percentile(&merged, 99.0),
+           lat_hist_percentile(&merged, 99.9),
+           merged.max_us);
 
     free(threads);
     free(args);
@@ -16,7 +16,7 @@ static void *client_handler(void *arg) {
     int client_fd  = ta->client_fd;
     free(ta);
 
-    struct message *msg = alloc_message(msg_size);
+    struct message *msg = alloc_message_slab(msg_size);
     if (!msg) {
         close(client_fd);
         return NULL;
@@ -34,26 +34,95 @@ static void *client_handler(void *arg) {
     mhdr.msg_iov    = iov;
     mhdr.msg_iovlen = NUM_FIELDS;
 
+    struct srv_conn_stats *stats = srv_stats_acquire();
+
     while (g_running) {
         /* One copy: kernel gathers from iovec into socket buffer */
+        double t0 = get_time_us();
         ssize_t ret = sendmsg(client_fd, &mhdr, 0);
-        if (ret <= 0) break;
+        if (ret <= 0) {
+            srv_stats_record_err(stats, errno);
+            break;
+        }
+        srv_stats_record(stats, ret, get_time_us() - t0);
     }
 
-    free_message(msg);
+    srv_stats_release(stats);
+
+    free_message_slab(msg);
     close(client_fd);
     return NULL;
 }
 
+/*
+ * Event-loop send step, one-copy flavor: the kernel gathers straight
+ * from the field iovecs into the socket buffer. EAGAIN means "wait for
+ * EPOLLOUT".
+ */
+static ssize_t epoll_send_one_copy(struct epoll_conn *conn) {
+    /* Gather from the unsent remainder so partial sends resume
+     * mid-message instead of reframing the stream */
+    struct iovec iov[NUM_FIELDS];
+    struct msghdr mhdr;
+    memset(&mhdr, 0, sizeof(mhdr));
+    mhdr.msg_iov    = iov;
+    mhdr.msg_iovlen = epoll_iov_from_offset(conn, iov);
+
+    ssize_t ret = sendmsg(conn->fd, &mhdr, 0);
+    if (ret < 0) {
+        srv_stats_record_err(conn->stats, errno);
+        return (errno == EAGAIN || errno == EWOULDBLOCK) ? 0 : -1;
+    }
+    epoll_conn_advance(conn, ret);
+    return ret;
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 3) {
-        fprintf(stderr, "Usage: %s <port> <message_size_bytes>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--epoll [num_loops]] [--sharded <N> [--pin-shards]] [--pace R] [--lowat B]\n", argv[0]);
         return EXIT_FAILURE;
     }
 
     int port     = atoi(argv[1]);
     int msg_size = atoi(argv[2]);
 
+    /* Optional modes: --epoll [num_loops], --sharded <N> [--pin-shards] */
+    int epoll_mode = 0;
+    int num_loops = 0;      /* 0 = one per online CPU */
+    int num_shards = 0;     /* 0 = sharded mode off */
+    int pin_shards = 0;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--epoll") == 0) {
+            epoll_mode = 1;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                num_loops = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--sharded") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --sharded requires a shard count >= 1\n");
+                return EXIT_FAILURE;
+            }
+            num_shards = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pin-shards") == 0) {
+            pin_shards = 1;
+        } else if (strcmp(argv[i], "--pace") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --pace requires msgs/sec >= 1\n");
+                return EXIT_FAILURE;
+            }
+            g_epoll_pace_rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lowat") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --lowat requires bytes >= 1\n");
+                return EXIT_FAILURE;
+            }
+            g_epoll_notsent_lowat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
     msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
     if (msg_size == 0) {
         fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
@@ -64,10 +133,36 @@ int main(int argc, char *argv[]) {
     install_signal_handler(SIGINT,  signal_handler);
     install_signal_handler(SIGTERM, signal_handler);
     install_signal_handler(SIGPIPE, SIG_IGN);
+    srv_stats_start("A2", 5);
+
+    /* Pacing runs on the event-loop engine; imply it when unset */
+    if ((g_epoll_pace_rate > 0 || g_epoll_notsent_lowat > 0)
+        && !epoll_mode && num_shards == 0) {
+        epoll_mode = 1;
+    }
+
+    /* Sharded mode creates its own per-shard listen sockets */
+    if (num_shards > 0) {
+        fprintf(stderr, "[A2-Server] Sharded mode on port %d, msg_size=%d\n",
+                port, msg_size);
+        run_sharded_server(port, msg_size, num_shards, pin_shards,
+                           epoll_send_one_copy, &g_running);
+        fprintf(stderr, "[A2-Server] Shutdown complete.\n");
+        return 0;
+    }
 
     int server_fd = create_server_socket(port);
     if (server_fd < 0) return EXIT_FAILURE;
 
+    if (epoll_mode) {
+        fprintf(stderr, "[A2-Server] Event-loop mode on port %d, "
+                "msg_size=%d\n", port, msg_size);
+        run_epoll_server(server_fd, msg_size, num_loops, epoll_send_one_copy, &g_running);
+        close(server_fd);
+        fprintf(stderr, "[A2-Server] Shutdown complete.\n");
+        return 0;
+    }
+
     fprintf(stderr, "[A2-Server] One-copy server listening on port %d, "
             "msg_size=%d, field_size=%d\n", port, msg_size, field_size);
 
@@ -22,6 +22,51 @@ static void signal_handler(int sig) {
     g_running = 0;
 }
 
+/*
+ * Drain zero-copy completion notifications, counting how many sends each
+ * batch acknowledges. The kernel reports completions as sequence ranges
+ * (ee_info..ee_data), so one errqueue message can retire many sends.
+ * Returns the number of sends completed; *batches counts the errqueue
+ * messages consumed.
+ */
+static long long drain_completions_counted(int fd, long long *batches) {
+    char cbuf[CMSG_SPACE(sizeof(struct sock_extended_err))];
+    struct msghdr msg;
+    struct iovec iov_dummy;
+    char dummy;
+    long long completed = 0;
+
+    iov_dummy.iov_base = &dummy;
+    iov_dummy.iov_len  = 0;
+
+    while (1) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+        msg.msg_iov        = &iov_dummy;
+        msg.msg_iovlen     = 1;
+
+        int ret = recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (ret < 0) break;
+
+        struct cmsghdr *cm = CMSG_FIRSTHDR(&msg);
+        if (cm == NULL) continue;
+        struct sock_extended_err *serr =
+            (struct sock_extended_err *)CMSG_DATA(cm);
+        if (serr->ee_errno != 0
+            || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+            continue;  /* a real socket error will surface on the send */
+        }
+
+        /* ee_info..ee_data is an inclusive range of completed sends */
+        completed += (long long)(serr->ee_data - serr->ee_info) + 1;
+        if (batches != NULL) {
+            (*batches)++;
+        }
+    }
+    return completed;
+}
+
 /* Drain zero-copy completion notifications from the error queue */
 static void drain_completions(int fd) {
     char cbuf[CMSG_SPACE(sizeof(struct sock_extended_err))];
@@ -51,16 +96,19 @@ static void *client_handler(void *arg) {
     int client_fd  = ta->client_fd;
     free(ta);
 
-    /* Enable zero-copy on this socket */
+    /* Enable zero-copy on this socket. Without it MSG_ZEROCOPY is
+     * silently ignored and no completions ever arrive, so the
+     * outstanding-send accounting below must be bypassed too. */
     int val = 1;
-    if (setsockopt(client_fd, SOL_SOCKET, SO_ZEROCOPY,
-                   &val, sizeof(val)) < 0) {
+    int zerocopy_active =
+        setsockopt(client_fd, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val)) == 0;
+    if (!zerocopy_active) {
         perror("setsockopt SO_ZEROCOPY");
         fprintf(stderr, "[A3-Server] Warning: zero-copy not supported, "
                 "falling back to normal send.\n");
     }
 
-    struct message *msg = alloc_message(msg_size);
+    struct message *msg = alloc_message_slab(msg_size);
     if (!msg) {
         close(client_fd);
         return NULL;
@@ -78,45 +126,215 @@ static void *client_handler(void *arg) {
     mhdr.msg_iov    = iov;
     mhdr.msg_iovlen = NUM_FIELDS;
 
+    /*
+     * Adaptive completion handling. The old fixed (send_count & 63)
+     * drain cadence plus busy ENOBUFS retry burned a full core spinning
+     * when the client was slow. Instead:
+     * - completions are awaited with epoll on the socket: pending
+     *   error-queue data (zero-copy acknowledgments) raises EPOLLERR,
+     *   so the thread sleeps instead of polling;
+     * - the cap on outstanding (unacknowledged) sends adapts AIMD-style
+     *   to observed completion latency: fast completions grow it toward
+     *   deeper pipelines, ENOBUFS or slow completions halve it.
+     */
+    int epfd = epoll_create1(0);
+    if (epfd >= 0) {
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = 0;  /* EPOLLERR is always reported */
+        epoll_ctl(epfd, EPOLL_CTL_ADD, client_fd, &ev);
+    }
+
+    struct srv_conn_stats *stats = srv_stats_acquire();
+
     long long send_count = 0;
+    long long outstanding = 0;
+    long long threshold = 64;        /* adaptive outstanding cap */
+    long long enobufs_events = 0;
+    long long completion_batches = 0;
+    long long total_completed = 0;
 
     while (g_running) {
+        /* At the cap: sleep until the error queue signals completions.
+         * Only reachable with zero-copy active (outstanding stays 0
+         * otherwise), so completions are guaranteed to arrive. */
+        while (outstanding >= threshold && g_running) {
+            double wait_start = get_time_us();
+            if (epfd >= 0) {
+                struct epoll_event ev;
+                (void)epoll_wait(epfd, &ev, 1, 100);
+            }
+            long long completed =
+                drain_completions_counted(client_fd, &completion_batches);
+            outstanding -= completed;
+            total_completed += completed;
+
+            if (completed > 0) {
+                /* Fast completions: deepen the pipeline additively;
+                 * slow ones (> 1 ms of waiting) halve it */
+                if (get_time_us() - wait_start < 1000.0) {
+                    if (threshold < 1024) {
+                        threshold += 8;
+                    }
+                } else if (threshold > 16) {
+                    threshold /= 2;
+                }
+            }
+        }
+        if (!g_running) {
+            break;
+        }
+
         /* Zero-copy: kernel pins user pages, NIC DMAs from them */
-        ssize_t ret = sendmsg(client_fd, &mhdr, MSG_ZEROCOPY);
+        double t0 = get_time_us();
+        ssize_t ret = sendmsg(client_fd, &mhdr,
+                              zerocopy_active ? MSG_ZEROCOPY : 0);
 
         if (ret < 0) {
+            srv_stats_record_err(stats, errno);
             if (errno == ENOBUFS) {
-                /* Too many outstanding buffers, drain and retry */
-                drain_completions(client_fd);
+                /* Out of optmem for pinned buffers: back the cap off
+                 * multiplicatively and wait for completions */
+                enobufs_events++;
+                if (threshold > 16) {
+                    threshold /= 2;
+                }
+                if (epfd >= 0) {
+                    struct epoll_event ev;
+                    (void)epoll_wait(epfd, &ev, 1, 100);
+                }
+                long long completed =
+                    drain_completions_counted(client_fd, &completion_batches);
+                outstanding -= completed;
+                total_completed += completed;
                 continue;
             }
             break;
         }
 
+        srv_stats_record(stats, ret, get_time_us() - t0);
         send_count++;
-
-        /* Drain completions every 64 sends to free buffers */
-        if ((send_count & 63) == 0) {
-            drain_completions(client_fd);
+        if (zerocopy_active) {
+            outstanding++;
         }
     }
 
-    drain_completions(client_fd);
+    /* Final drain so the counters reflect the whole connection */
+    total_completed += drain_completions_counted(client_fd, &completion_batches);
+
+    fprintf(stderr, "[A3-Server] conn closed: %lld sends, %lld ENOBUFS, "
+            "%lld completions in %lld batches (avg %.1f/batch), "
+            "final threshold %lld\n",
+            send_count, enobufs_events, total_completed, completion_batches,
+            completion_batches > 0
+                ? (double)total_completed / (double)completion_batches : 0.0,
+            threshold);
+
+    srv_stats_release(stats);
 
-    free_message(msg);
+    if (epfd >= 0) {
+        close(epfd);
+    }
+    free_message_slab(msg);
     close(client_fd);
     return NULL;
 }
 
+/*
+ * Event-loop send step, zero-copy flavor: MSG_ZEROCOPY pins the field
+ * pages for DMA. Completions are drained on the same cadence as the
+ * thread-per-connection path; ENOBUFS (too many pinned buffers) drains
+ * and backs off until the next EPOLLOUT.
+ */
+static ssize_t epoll_send_zero_copy(struct epoll_conn *conn) {
+    /* The generic accept path does not know about SO_ZEROCOPY; enable it
+     * lazily before the first successful send (idempotent on retries).
+     * Without it the kernel silently falls back to copying. */
+    if (conn->send_count == 0) {
+        int val = 1;
+        setsockopt(conn->fd, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val));
+    }
+
+    /* Gather from the unsent remainder so partial sends resume
+     * mid-message instead of reframing the stream */
+    struct iovec iov[NUM_FIELDS];
+    struct msghdr mhdr;
+    memset(&mhdr, 0, sizeof(mhdr));
+    mhdr.msg_iov    = iov;
+    mhdr.msg_iovlen = epoll_iov_from_offset(conn, iov);
+
+    ssize_t ret = sendmsg(conn->fd, &mhdr, MSG_ZEROCOPY);
+    if (ret < 0) {
+        srv_stats_record_err(conn->stats, errno);
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            /* Pending completions keep level-triggered EPOLLERR raised;
+             * drain them here or a stalled receiver turns every
+             * epoll_wait into an immediate wakeup that sends nothing -
+             * the same busy-burn the threaded path already lost */
+            drain_completions(conn->fd);
+            return 0;
+        }
+        if (errno == ENOBUFS) {
+            drain_completions(conn->fd);
+            return 0;
+        }
+        return -1;
+    }
+    epoll_conn_advance(conn, ret);
+
+    conn->send_count++;
+    if ((conn->send_count & 63) == 0) {
+        drain_completions(conn->fd);
+    }
+    return ret;
+}
+
 int main(int argc, char *argv[]) {
     if (argc < 3) {
-        fprintf(stderr, "Usage: %s <port> <message_size_bytes>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--epoll [num_loops]] [--sharded <N> [--pin-shards]] [--pace R] [--lowat B]\n", argv[0]);
         return EXIT_FAILURE;
     }
 
     int port     = atoi(argv[1]);
     int msg_size = atoi(argv[2]);
 
+    /* Optional modes: --epoll [num_loops], --sharded <N> [--pin-shards] */
+    int epoll_mode = 0;
+    int num_loops = 0;      /* 0 = one per online CPU */
+    int num_shards = 0;     /* 0 = sharded mode off */
+    int pin_shards = 0;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--epoll") == 0) {
+            epoll_mode = 1;
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0) {
+                num_loops = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--sharded") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --sharded requires a shard count >= 1\n");
+                return EXIT_FAILURE;
+            }
+            num_shards = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pin-shards") == 0) {
+            pin_shards = 1;
+        } else if (strcmp(argv[i], "--pace") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --pace requires msgs/sec >= 1\n");
+                return EXIT_FAILURE;
+            }
+            g_epoll_pace_rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lowat") == 0) {
+            if (i + 1 >= argc || atoi(argv[i + 1]) < 1) {
+                fprintf(stderr, "Error: --lowat requires bytes >= 1\n");
+                return EXIT_FAILURE;
+            }
+            g_epoll_notsent_lowat = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
     msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
     if (msg_size == 0) {
         fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
@@ -127,10 +345,36 @@ int main(int argc, char *argv[]) {
     install_signal_handler(SIGINT,  signal_handler);
     install_signal_handler(SIGTERM, signal_handler);
     install_signal_handler(SIGPIPE, SIG_IGN);
+    srv_stats_start("A3", 5);
+
+    /* Pacing runs on the event-loop engine; imply it when unset */
+    if ((g_epoll_pace_rate > 0 || g_epoll_notsent_lowat > 0)
+        && !epoll_mode && num_shards == 0) {
+        epoll_mode = 1;
+    }
+
+    /* Sharded mode creates its own per-shard listen sockets */
+    if (num_shards > 0) {
+        fprintf(stderr, "[A3-Server] Sharded mode on port %d, msg_size=%d\n",
+                port, msg_size);
+        run_sharded_server(port, msg_size, num_shards, pin_shards,
+                           epoll_send_zero_copy, &g_running);
+        fprintf(stderr, "[A3-Server] Shutdown complete.\n");
+        return 0;
+    }
 
     int server_fd = create_server_socket(port);
     if (server_fd < 0) return EXIT_FAILURE;
 
+    if (epoll_mode) {
+        fprintf(stderr, "[A3-Server] Event-loop mode on port %d, "
+                "msg_size=%d\n", port, msg_size);
+        run_epoll_server(server_fd, msg_size, num_loops, epoll_send_zero_copy, &g_running);
+        close(server_fd);
+        fprintf(stderr, "[A3-Server] Shutdown complete.\n");
+        return 0;
+    }
+
     fprintf(stderr, "[A3-Server] Zero-copy server listening on port %d, "
             "msg_size=%d, field_size=%d\n", port, msg_size, field_size);
 
@@ -0,0 +1,350 @@
+/* MT25077_Part_A4_Server.c - io_uring TCP Server (registered buffers) */
+
+/*
+ * The next rung above MSG_ZEROCOPY on the copy-avoidance ladder: sends
+ * are submitted through an io_uring with the message buffers registered
+ * up front (IORING_REGISTER_BUFFERS pins them once instead of per-send),
+ * and --sqpoll starts a kernel submission thread so the hot loop makes
+ * no submit syscalls at all. The message keeps the same layout as
+ * A1-A3: NUM_FIELDS contiguous field areas filled with the 'A'+i
+ * pattern, so clients and results stay comparable. Raw syscalls are
+ * used throughout - no liburing dependency.
+ *
+ * One ring, one thread: accepts and sends all complete through the same
+ * completion queue. Each connection owns one registered buffer slot and
+ * keeps exactly one write in flight - concurrent writes on one TCP
+ * socket complete in arbitrary order and would interleave, and a short
+ * completion must resume mid-message, so the next write always starts
+ * at the first unsent byte of the current message.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <linux/io_uring.h>
+
+/* Connection slots == registered buffer slots */
+#define A4_MAX_CONNS      64
+#define A4_RING_ENTRIES   512
+
+/* user_data encoding: operation in the high word, slot in the low */
+#define A4_OP_ACCEPT 1ULL
+#define A4_OP_SEND   2ULL
+#define A4_UDATA(op, slot) (((op) << 32) | (unsigned long long)(slot))
+#define A4_UDATA_OP(u)     ((u) >> 32)
+#define A4_UDATA_SLOT(u)   ((int)((u) & 0xffffffffULL))
+
+static volatile int g_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+/* ---- minimal raw-syscall ring (same shape as the PA01 worker's) ---- */
+struct a4_ring {
+    int ring_fd;
+    unsigned sq_entries;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array, *sq_flags;
+    struct io_uring_sqe *sqes;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_ring_ptr, *cq_ring_ptr;
+    size_t sq_ring_sz, cq_ring_sz, sqes_sz;
+    int sqpoll;
+};
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                        flags, NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, const void *arg,
+                                 unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+static int a4_ring_init(struct a4_ring *ring, unsigned entries, int sqpoll) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    if (sqpoll) {
+        p.flags = IORING_SETUP_SQPOLL;
+        p.sq_thread_idle = 1000;  /* ms before the kernel thread naps */
+    }
+
+    ring->ring_fd = sys_io_uring_setup(entries, &p);
+    if (ring->ring_fd < 0) {
+        return -1;
+    }
+    ring->sqpoll = sqpoll;
+
+    ring->sq_ring_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_ring_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_sz    = p.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ring_ptr = mmap(NULL, ring->sq_ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_SQ_RING);
+    ring->cq_ring_ptr = mmap(NULL, ring->cq_ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_CQ_RING);
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_sz,
+                             PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->ring_fd,
+                             IORING_OFF_SQES);
+    if (ring->sq_ring_ptr == MAP_FAILED || ring->cq_ring_ptr == MAP_FAILED ||
+        ring->sqes == MAP_FAILED) {
+        close(ring->ring_fd);
+        return -1;
+    }
+
+    char *sq = (char *)ring->sq_ring_ptr;
+    ring->sq_entries = p.sq_entries;
+    ring->sq_head  = (unsigned *)(sq + p.sq_off.head);
+    ring->sq_tail  = (unsigned *)(sq + p.sq_off.tail);
+    ring->sq_mask  = (unsigned *)(sq + p.sq_off.ring_mask);
+    ring->sq_flags = (unsigned *)(sq + p.sq_off.flags);
+    ring->sq_array = (unsigned *)(sq + p.sq_off.array);
+
+    char *cq = (char *)ring->cq_ring_ptr;
+    ring->cq_head = (unsigned *)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    ring->cqes    = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    return 0;
+}
+
+static struct io_uring_sqe *a4_get_sqe(struct a4_ring *ring) {
+    unsigned tail = *ring->sq_tail;
+    unsigned idx  = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[idx] = idx;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    return sqe;
+}
+
+/* Submit queued SQEs and optionally wait for one completion. With
+ * SQPOLL the kernel thread consumes the queue; only wake it if it
+ * went to sleep. */
+static int a4_submit(struct a4_ring *ring, unsigned to_submit, int wait) {
+    if (ring->sqpoll) {
+        unsigned flags = 0;
+        if (__atomic_load_n(ring->sq_flags, __ATOMIC_ACQUIRE)
+                & IORING_SQ_NEED_WAKEUP) {
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        }
+        if (wait) {
+            flags |= IORING_ENTER_GETEVENTS;
+        }
+        if (flags == 0) {
+            return 0;  /* kernel thread is awake and nothing to wait on */
+        }
+        return sys_io_uring_enter(ring->ring_fd, 0, wait ? 1 : 0, flags);
+    }
+    return sys_io_uring_enter(ring->ring_fd, to_submit, wait ? 1 : 0,
+                              wait ? IORING_ENTER_GETEVENTS : 0);
+}
+
+/* ---- connection slots backed by registered buffers ---- */
+struct a4_conn {
+    int    fd;           /* -1 when the slot is free */
+    size_t send_offset;  /* bytes of the current message already sent */
+};
+
+static struct a4_conn g_conns[A4_MAX_CONNS];
+static char *g_buffers[A4_MAX_CONNS];
+static int g_msg_size;
+static struct sockaddr_in g_accept_addr;
+static socklen_t g_accept_len;
+
+/* Queue the slot's single registered-buffer write, starting at the
+ * first unsent byte of the current message */
+static void a4_queue_send(struct a4_ring *ring, int slot) {
+    struct io_uring_sqe *sqe = a4_get_sqe(ring);
+    sqe->opcode    = IORING_OP_WRITE_FIXED;
+    sqe->fd        = g_conns[slot].fd;
+    sqe->addr      = (unsigned long)(g_buffers[slot]
+                                     + g_conns[slot].send_offset);
+    sqe->len       = (unsigned)((size_t)g_msg_size
+                                - g_conns[slot].send_offset);
+    sqe->buf_index = (unsigned short)slot;
+    sqe->user_data = A4_UDATA(A4_OP_SEND, slot);
+}
+
+static void a4_queue_accept(struct a4_ring *ring, int listen_fd) {
+    struct io_uring_sqe *sqe = a4_get_sqe(ring);
+    g_accept_len = sizeof(g_accept_addr);
+    sqe->opcode    = IORING_OP_ACCEPT;
+    sqe->fd        = listen_fd;
+    sqe->addr      = (unsigned long)&g_accept_addr;
+    sqe->off       = (unsigned long)&g_accept_len;
+    sqe->user_data = A4_UDATA(A4_OP_ACCEPT, 0);
+}
+
+static void a4_close_slot(int slot) {
+    if (g_conns[slot].fd >= 0) {
+        close(g_conns[slot].fd);
+        g_conns[slot].fd = -1;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--sqpoll]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int port     = atoi(argv[1]);
+    int msg_size = atoi(argv[2]);
+    int sqpoll   = (argc > 3 && strcmp(argv[3], "--sqpoll") == 0);
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0) {
+        fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
+        return EXIT_FAILURE;
+    }
+    int field_size = msg_size / NUM_FIELDS;
+    g_msg_size = msg_size;
+
+    install_signal_handler(SIGINT,  signal_handler);
+    install_signal_handler(SIGTERM, signal_handler);
+    install_signal_handler(SIGPIPE, SIG_IGN);
+
+    struct a4_ring ring;
+    if (a4_ring_init(&ring, A4_RING_ENTRIES, sqpoll) != 0) {
+        if (sqpoll) {
+            fprintf(stderr, "[A4-Server] SQPOLL setup failed (%s); "
+                    "retrying without it\n", strerror(errno));
+            sqpoll = 0;
+            if (a4_ring_init(&ring, A4_RING_ENTRIES, 0) != 0) {
+                perror("io_uring_setup");
+                return EXIT_FAILURE;
+            }
+        } else {
+            perror("io_uring_setup");
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* One page-aligned buffer per connection slot, same field layout and
+     * pattern as alloc_message_slab() produces, registered up front so
+     * the kernel pins the pages once instead of per send */
+    struct iovec reg_iovs[A4_MAX_CONNS];
+    for (int i = 0; i < A4_MAX_CONNS; i++) {
+        size_t sz = ((size_t)msg_size + 4095) & ~(size_t)4095;
+        g_buffers[i] = (char *)aligned_alloc(4096, sz);
+        if (!g_buffers[i]) {
+            perror("aligned_alloc");
+            return EXIT_FAILURE;
+        }
+        for (int f = 0; f < NUM_FIELDS; f++) {
+            memset(g_buffers[i] + (size_t)f * (size_t)field_size, 'A' + f,
+                   (size_t)field_size);
+        }
+        reg_iovs[i].iov_base = g_buffers[i];
+        reg_iovs[i].iov_len  = (size_t)msg_size;
+        g_conns[i].fd = -1;
+    }
+    if (sys_io_uring_register(ring.ring_fd, IORING_REGISTER_BUFFERS,
+                              reg_iovs, A4_MAX_CONNS) != 0) {
+        perror("IORING_REGISTER_BUFFERS");
+        return EXIT_FAILURE;
+    }
+
+    int server_fd = create_server_socket(port);
+    if (server_fd < 0) return EXIT_FAILURE;
+
+    fprintf(stderr, "[A4-Server] io_uring server listening on port %d, "
+            "msg_size=%d, field_size=%d, registered buffers=%d%s\n",
+            port, msg_size, field_size, A4_MAX_CONNS,
+            sqpoll ? ", SQPOLL" : "");
+
+    a4_queue_accept(&ring, server_fd);
+    unsigned pending = 1;
+
+    while (g_running) {
+        int ret = a4_submit(&ring, pending, 1);
+        pending = 0;
+        if (ret < 0 && errno != EINTR) {
+            perror("io_uring_enter");
+            break;
+        }
+
+        /* Reap everything available */
+        unsigned head = *ring.cq_head;
+        while (head != __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE)) {
+            struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cq_mask];
+            unsigned long long op = A4_UDATA_OP(cqe->user_data);
+            int slot = A4_UDATA_SLOT(cqe->user_data);
+
+            if (op == A4_OP_ACCEPT) {
+                if (cqe->res >= 0) {
+                    int client_fd = cqe->res;
+                    int flag = 1;
+                    setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY,
+                               &flag, sizeof(flag));
+
+                    /* Find a free slot; refuse past capacity */
+                    int free_slot = -1;
+                    for (int i = 0; i < A4_MAX_CONNS; i++) {
+                        if (g_conns[i].fd < 0) {
+                            free_slot = i;
+                            break;
+                        }
+                    }
+                    if (free_slot < 0) {
+                        fprintf(stderr, "[A4-Server] connection limit %d "
+                                "reached, refusing\n", A4_MAX_CONNS);
+                        close(client_fd);
+                    } else {
+                        g_conns[free_slot].fd = client_fd;
+                        g_conns[free_slot].send_offset = 0;
+                        a4_queue_send(&ring, free_slot);
+                        pending++;
+                    }
+                }
+                a4_queue_accept(&ring, server_fd);
+                pending++;
+            } else if (op == A4_OP_SEND) {
+                if (g_conns[slot].fd >= 0) {
+                    if (cqe->res > 0) {
+                        /* Advance past the completed bytes; a short
+                         * write resumes mid-message, a full one starts
+                         * the next message from the buffer head */
+                        g_conns[slot].send_offset += (size_t)cqe->res;
+                        if (g_conns[slot].send_offset
+                                >= (size_t)g_msg_size) {
+                            g_conns[slot].send_offset = 0;
+                        }
+                        a4_queue_send(&ring, slot);
+                        pending++;
+                    } else {
+                        /* Peer went away; one send in flight means the
+                         * slot is free as soon as it completes */
+                        a4_close_slot(slot);
+                    }
+                }
+            }
+
+            head++;
+        }
+        __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    for (int i = 0; i < A4_MAX_CONNS; i++) {
+        a4_close_slot(i);
+        free(g_buffers[i]);
+    }
+    close(server_fd);
+    close(ring.ring_fd);
+    fprintf(stderr, "[A4-Server] Shutdown complete.\n");
+    return 0;
+}
@@ -0,0 +1,207 @@
+/* MT25077_Part_A5_Client.c - File-Backed Server Counterpart Client */
+
+#include "MT25077_Part_A_Common.h"
+
+static void *client_thread_fn(void *arg) {
+    struct client_thread_args *cta = (struct client_thread_args *)arg;
+    int msg_size = cta->msg_size;
+
+    int sock = connect_to_server(cta->server_ip, cta->port);
+    if (sock < 0) return NULL;
+
+    char *recv_buf = (char *)malloc(msg_size);
+    if (!recv_buf) {
+        perror("malloc recv_buf");
+        close(sock);
+        return NULL;
+    }
+
+    /* Scatter-gather mode: 8 per-field buffers matching the server's
+     * message layout, so the receive side of the copy comparison is
+     * instrumented too instead of collapsing into one flat buffer */
+    int field_size = msg_size / NUM_FIELDS;
+    struct message *sg_msg = NULL;
+    if (cta->sg_mode) {
+        sg_msg = alloc_message(msg_size);
+        if (!sg_msg) {
+            free(recv_buf);
+            close(sock);
+            return NULL;
+        }
+    }
+
+    struct timespec cpu_t0, cpu_t1;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_t0);
+
+    double start_time = get_time_us();
+    double end_time   = start_time + (double)cta->duration * 1e6;
+    double total_latency = 0.0;
+    long long bytes = 0, msgs = 0;
+
+    /* Receive loop: run for specified duration, measure per-msg latency */
+    while (get_time_us() < end_time) {
+        double msg_start = get_time_us();
+        ssize_t ret;
+        if (cta->sg_mode) {
+            /* Fresh iovecs each message: recv_all_vec consumes them */
+            struct iovec iov[NUM_FIELDS];
+            for (int i = 0; i < NUM_FIELDS; i++) {
+                iov[i].iov_base = sg_msg->fields[i];
+                iov[i].iov_len  = (size_t)field_size;
+            }
+            ret = recv_all_vec(sock, iov, NUM_FIELDS, (size_t)msg_size);
+            if (ret > 0) {
+                /* Verify the field patterns in place */
+                for (int i = 0; i < NUM_FIELDS; i++) {
+                    const char *p = sg_msg->fields[i];
+                    for (int j = 0; j < field_size; j++) {
+                        if (p[j] != 'A' + i) {
+                            cta->verify_errors++;
+                            break;
+                        }
+                    }
+                }
+            }
+        } else {
+            ret = recv_all(sock, recv_buf, msg_size);
+        }
+        if (ret <= 0) break;
+
+        double msg_end = get_time_us();
+        total_latency += (msg_end - msg_start);
+        lat_hist_record(&cta->hist, msg_end - msg_start);
+        bytes += msg_size;
+        msgs++;
+    }
+
+    double elapsed_s = (get_time_us() - start_time) / 1e6;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_t1);
+    cta->cpu_time_s = (double)(cpu_t1.tv_sec - cpu_t0.tv_sec)
+                      + (double)(cpu_t1.tv_nsec - cpu_t0.tv_nsec) / 1e9;
+
+    cta->bytes_received    = bytes;
+    cta->messages_received = msgs;
+    cta->total_latency_us  = total_latency;
+
+    fprintf(stderr, "  Thread %d: %.2f MB, %.4f Gbps, avg_lat=%.2f us\n",
+            cta->thread_id,
+            bytes / (1024.0 * 1024.0),
+            (bytes * 8.0) / (elapsed_s * 1e9),
+            msgs > 0 ? total_latency / msgs : 0.0);
+
+    if (cta->sg_mode && bytes > 0) {
+        fprintf(stderr, "  Thread %d: sg receive %.3f CPU ns/byte, "
+                "%lld verify errors\n",
+                cta->thread_id,
+                cta->cpu_time_s * 1e9 / (double)bytes,
+                cta->verify_errors);
+    }
+
+    free_message(sg_msg);
+    free(recv_buf);
+    close(sock);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr,
+                "Usage: %s <server_ip> <port> <msg_size> <thread_count> "
+                "[duration_s] [--sg]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* Optional trailing flag: scatter-gather receive into field buffers */
+    int sg_mode = 0;
+    if (strcmp(argv[argc - 1], "--sg") == 0) {
+        sg_mode = 1;
+        argc--;
+    }
+
+    const char *server_ip = argv[1];
+    int port         = atoi(argv[2]);
+    int msg_size     = atoi(argv[3]);
+    int thread_count = atoi(argv[4]);
+    int duration     = (argc > 5) ? atoi(argv[5]) : DEFAULT_DURATION;
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0) {
+        fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "[A5-Client] sendfile: server=%s:%d msg_size=%d "
+            "threads=%d duration=%ds\n",
+            server_ip, port, msg_size, thread_count, duration);
+
+    pthread_t *threads = (pthread_t *)malloc(sizeof(pthread_t) * thread_count);
+    struct client_thread_args *args = (struct client_thread_args *)
+        calloc(thread_count, sizeof(struct client_thread_args));
+
+    for (int i = 0; i < thread_count; i++) {
+        args[i].server_ip = server_ip;
+        args[i].port      = port;
+        args[i].msg_size  = msg_size;
+        args[i].duration  = duration;
+        args[i].thread_id = i;
+        args[i].sg_mode   = sg_mode;
+        pthread_create(&threads[i], NULL, client_thread_fn, &args[i]);
+    }
+
+    long long total_bytes = 0, total_msgs = 0;
+    double total_latency = 0.0;
+    struct lat_hist merged;
+    memset(&merged, 0, sizeof(merged));
+
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        total_bytes   += args[i].bytes_received;
+        total_msgs    += args[i].messages_received;
+        total_latency += args[i].total_latency_us;
+        lat_hist_merge(&merged, &args[i].hist);
+    }
+
+    double throughput_gbps = (total_bytes * 8.0) / ((double)duration * 1e9);
+    double avg_latency_us  = total_msgs > 0
+                             ? total_latency / (double)total_msgs
+                             : 0.0;
+
+    fprintf(stderr, "\n=== AGGREGATE RESULTS (sendfile) ===\n");
+    fprintf(stderr, "Total bytes:  %lld\n", total_bytes);
+    fprintf(stderr, "Total msgs:   %lld\n", total_msgs);
+    fprintf(stderr, "Throughput:   %.4f Gbps\n", throughput_gbps);
+    fprintf(stderr, "Avg latency:  %.2f us\n", avg_latency_us);
+    if (sg_mode) {
+        double cpu_s = 0.0;
+        long long verify_errors = 0;
+        for (int i = 0; i < thread_count; i++) {
+            cpu_s += args[i].cpu_time_s;
+            verify_errors += args[i].verify_errors;
+        }
+        fprintf(stderr, "SG receive:   %.3f CPU ns/byte, %lld verify errors\n",
+                total_bytes > 0 ? cpu_s * 1e9 / (double)total_bytes : 0.0,
+                verify_errors);
+    }
+    fprintf(stderr, "Latency percentiles: p50=%.0f p90=%.0f p99=%.0f "
+            "p99.9=%.0f max=%.0f us\n",
+            lat_hist_percentile(&merged, 50.0),
+            lat_hist_percentile(&merged, 90.0),
+            lat_hist_percentile(&merged, 99.0),
+            lat_hist_percentile(&merged, 99.9),
+            merged.max_us);
+
+    /* Machine-parseable CSV line to stdout for experiment script */
+    printf("RESULT,sendfile,%d,%d,%.4f,%.2f,%lld,%lld,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+           msg_size, thread_count, throughput_gbps, avg_latency_us,
+           total_bytes, total_msgs,
+           lat_hist_percentile(&merged, 50.0),
+           lat_hist_percentile(&merged, 90.0),
+           lat_hist_percentile(&merged, 99.0),
+           lat_hist_percentile(&merged, 99.9),
+           merged.max_us);
+
+    free(threads);
+    free(args);
+    return 0;
+}
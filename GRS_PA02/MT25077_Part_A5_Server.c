@@ -0,0 +1,198 @@
+/* MT25077_Part_A5_Server.c - File-Backed TCP Server (sendfile/splice) */
+
+/*
+ * A1-A3 transmit heap-resident messages, but file-backed egress can skip
+ * user space entirely: the message content is generated into a file once
+ * at startup, and every send moves it from the page cache straight into
+ * the socket with sendfile() - or, with --splice, through a pipe with
+ * splice() so the payload travels as page references end to end. The
+ * file holds one message in the usual 8-field 'A'+i pattern layout, so
+ * clients and result lines stay comparable with the other variants.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+static volatile int g_running = 1;
+
+/* Payload file shared by all connections, opened once at startup */
+static int g_payload_fd = -1;
+static int g_msg_size;
+static int g_use_splice;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+/* Generate the one-message payload file and unlink it immediately so it
+ * lives only as long as the descriptor */
+static int create_payload_file(int msg_size, int field_size) {
+    char path[256];
+    snprintf(path, sizeof(path), "/tmp/a5_payload_%d.dat", getpid());
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror("open payload file");
+        return -1;
+    }
+    unlink(path);
+
+    char *buf = (char *)malloc((size_t)msg_size);
+    if (!buf) {
+        close(fd);
+        return -1;
+    }
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        memset(buf + (size_t)i * (size_t)field_size, 'A' + i,
+               (size_t)field_size);
+    }
+    if (write(fd, buf, (size_t)msg_size) != (ssize_t)msg_size) {
+        perror("write payload file");
+        free(buf);
+        close(fd);
+        return -1;
+    }
+    free(buf);
+    return fd;
+}
+
+static void *client_handler(void *arg) {
+    struct server_thread_args *ta = (struct server_thread_args *)arg;
+    int client_fd = ta->client_fd;
+    free(ta);
+
+    if (g_use_splice) {
+        /* splice path: file -> pipe -> socket, pages moved by reference */
+        int pipefd[2];
+        if (pipe(pipefd) != 0) {
+            perror("pipe");
+            close(client_fd);
+            return NULL;
+        }
+
+        while (g_running) {
+            /* Move the whole message, one pipe-full at a time: the pipe
+             * holds less than large messages, so keep advancing the file
+             * offset until all msg_size bytes have passed through */
+            loff_t off = 0;
+            int failed = 0;
+            while (off < (loff_t)g_msg_size && !failed) {
+                ssize_t in_pipe = splice(g_payload_fd, &off, pipefd[1], NULL,
+                                         (size_t)g_msg_size - (size_t)off,
+                                         SPLICE_F_MOVE);
+                if (in_pipe <= 0) {
+                    failed = 1;
+                    break;
+                }
+
+                ssize_t sent_total = 0;
+                while (sent_total < in_pipe) {
+                    ssize_t sent = splice(pipefd[0], NULL, client_fd, NULL,
+                                          (size_t)(in_pipe - sent_total),
+                                          SPLICE_F_MOVE | SPLICE_F_MORE);
+                    if (sent <= 0) {
+                        failed = 1;
+                        break;
+                    }
+                    sent_total += sent;
+                }
+            }
+            if (failed) break;
+        }
+
+        close(pipefd[0]);
+        close(pipefd[1]);
+    } else {
+        /* sendfile path: page cache -> socket in one syscall */
+        while (g_running) {
+            off_t off = 0;
+            ssize_t remaining = g_msg_size;
+            while (remaining > 0) {
+                ssize_t sent = sendfile(client_fd, g_payload_fd, &off,
+                                        (size_t)remaining);
+                if (sent <= 0) {
+                    remaining = -1;
+                    break;
+                }
+                remaining -= sent;
+            }
+            if (remaining < 0) break;
+        }
+    }
+
+    close(client_fd);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--splice]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int port     = atoi(argv[1]);
+    int msg_size = atoi(argv[2]);
+    g_use_splice = (argc > 3 && strcmp(argv[3], "--splice") == 0);
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0) {
+        fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
+        return EXIT_FAILURE;
+    }
+    int field_size = msg_size / NUM_FIELDS;
+    g_msg_size = msg_size;
+
+    install_signal_handler(SIGINT,  signal_handler);
+    install_signal_handler(SIGTERM, signal_handler);
+    install_signal_handler(SIGPIPE, SIG_IGN);
+
+    g_payload_fd = create_payload_file(msg_size, field_size);
+    if (g_payload_fd < 0) {
+        return EXIT_FAILURE;
+    }
+
+    int server_fd = create_server_socket(port);
+    if (server_fd < 0) return EXIT_FAILURE;
+
+    fprintf(stderr, "[A5-Server] File-backed server (%s) listening on port "
+            "%d, msg_size=%d, field_size=%d\n",
+            g_use_splice ? "splice" : "sendfile", port, msg_size, field_size);
+
+    while (g_running) {
+        struct sockaddr_in client_addr;
+        socklen_t client_len = sizeof(client_addr);
+
+        int client_fd = accept(server_fd,
+                               (struct sockaddr *)&client_addr, &client_len);
+        if (client_fd < 0) {
+            if (!g_running) break;
+            perror("accept");
+            continue;
+        }
+
+        struct server_thread_args *ta = (struct server_thread_args *)
+            calloc(1, sizeof(struct server_thread_args));
+        ta->client_fd  = client_fd;
+        ta->msg_size   = msg_size;
+        ta->field_size = field_size;
+
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, client_handler, ta) != 0) {
+            perror("pthread_create");
+            free(ta);
+            close(client_fd);
+            continue;
+        }
+        pthread_detach(tid);
+    }
+
+    close(server_fd);
+    close(g_payload_fd);
+    fprintf(stderr, "[A5-Server] Shutdown complete.\n");
+    return 0;
+}
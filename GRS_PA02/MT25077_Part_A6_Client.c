@@ -0,0 +1,213 @@
+/* MT25077_Part_A6_Client.c - UDP Client (UDP_GRO receive) */
+
+/*
+ * Receiver for the UDP variant: each thread opens its own socket, sends
+ * a hello so the server learns where to blast, and receives for the
+ * experiment duration. UDP_GRO is enabled by default so the kernel
+ * coalesces segments back into super-datagrams before the recv copy
+ * (--plain disables it for the baseline). Throughput counts received
+ * bytes; messages are bytes / msg_size, so datagram loss shows up as
+ * missing messages rather than an error.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#define UDP_RECV_BUF (64 * 1024)
+
+static int g_plain;
+
+static void *client_thread_fn(void *arg) {
+    struct client_thread_args *cta = (struct client_thread_args *)arg;
+    int msg_size = cta->msg_size;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("socket");
+        return NULL;
+    }
+
+    if (!g_plain) {
+        int on = 1;
+        if (setsockopt(sock, SOL_UDP, UDP_GRO, &on, sizeof(on)) < 0) {
+            perror("setsockopt UDP_GRO");
+            fprintf(stderr, "  Thread %d: GRO unavailable, plain receive\n",
+                    cta->thread_id);
+        }
+    }
+
+    /* Grow the receive buffer; the sender has no backpressure */
+    int rcvbuf = 4 * 1024 * 1024;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    struct sockaddr_in server;
+    memset(&server, 0, sizeof(server));
+    server.sin_family = AF_INET;
+    server.sin_port   = htons(cta->port);
+    if (inet_pton(AF_INET, cta->server_ip, &server.sin_addr) <= 0) {
+        perror("inet_pton");
+        close(sock);
+        return NULL;
+    }
+
+    /* Hello datagram: tells the server this socket's address */
+    if (sendto(sock, "HELLO", 5, 0,
+               (struct sockaddr *)&server, sizeof(server)) < 0) {
+        perror("sendto hello");
+        close(sock);
+        return NULL;
+    }
+
+    char *recv_buf = (char *)malloc(UDP_RECV_BUF);
+    if (!recv_buf) {
+        perror("malloc recv_buf");
+        close(sock);
+        return NULL;
+    }
+
+    /* Receive with a timeout so the duration is honored even on loss */
+    struct timeval tv = { 1, 0 };
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    double start_time = get_time_us();
+    double end_time   = start_time + (double)cta->duration * 1e6;
+    double total_latency = 0.0;
+    long long bytes = 0, msgs = 0;
+
+    while (get_time_us() < end_time) {
+        double msg_start = get_time_us();
+        ssize_t ret = recv(sock, recv_buf, UDP_RECV_BUF, 0);
+        if (ret < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                continue;  /* timeout tick: re-check the deadline */
+            }
+            break;
+        }
+
+        double msg_end = get_time_us();
+        long long got = ret / msg_size;
+        if (got < 1) got = 1;
+        total_latency += (msg_end - msg_start);
+        lat_hist_record(&cta->hist, msg_end - msg_start);
+        bytes += ret;
+        msgs += got;
+    }
+
+    double elapsed_s = (get_time_us() - start_time) / 1e6;
+
+    cta->bytes_received    = bytes;
+    cta->messages_received = msgs;
+    cta->total_latency_us  = total_latency;
+
+    fprintf(stderr, "  Thread %d: %.2f MB, %.4f Gbps, %lld msgs\n",
+            cta->thread_id,
+            bytes / (1024.0 * 1024.0),
+            (bytes * 8.0) / (elapsed_s * 1e9),
+            msgs);
+
+    free(recv_buf);
+    close(sock);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    /* Optional trailing flag: disable GRO for the baseline */
+    if (argc > 1 && strcmp(argv[argc - 1], "--plain") == 0) {
+        g_plain = 1;
+        argc--;
+    }
+
+    if (argc < 5) {
+        fprintf(stderr,
+                "Usage: %s <server_ip> <port> <msg_size> <thread_count> "
+                "[duration_s] [--plain]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *server_ip = argv[1];
+    int port         = atoi(argv[2]);
+    int msg_size     = atoi(argv[3]);
+    int thread_count = atoi(argv[4]);
+    int duration     = (argc > 5) ? atoi(argv[5]) : DEFAULT_DURATION;
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0) {
+        fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
+        return EXIT_FAILURE;
+    }
+
+    fprintf(stderr, "[A6-Client] %s: server=%s:%d msg_size=%d "
+            "threads=%d duration=%ds\n",
+            g_plain ? "udp_plain" : "udp_gso",
+            server_ip, port, msg_size, thread_count, duration);
+
+    pthread_t *threads = (pthread_t *)malloc(sizeof(pthread_t) * thread_count);
+    struct client_thread_args *args = (struct client_thread_args *)
+        calloc(thread_count, sizeof(struct client_thread_args));
+
+    for (int i = 0; i < thread_count; i++) {
+        args[i].server_ip = server_ip;
+        args[i].port      = port;
+        args[i].msg_size  = msg_size;
+        args[i].duration  = duration;
+        args[i].thread_id = i;
+        pthread_create(&threads[i], NULL, client_thread_fn, &args[i]);
+    }
+
+    long long total_bytes = 0, total_msgs = 0;
+    double total_latency = 0.0;
+    struct lat_hist merged;
+    memset(&merged, 0, sizeof(merged));
+
+    for (int i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        total_bytes   += args[i].bytes_received;
+        total_msgs    += args[i].messages_received;
+        total_latency += args[i].total_latency_us;
+        lat_hist_merge(&merged, &args[i].hist);
+    }
+
+    double throughput_gbps = (total_bytes * 8.0) / ((double)duration * 1e9);
+
+    /* Latency samples are per recv() call (one per super-datagram under
+     * GRO), so average over the recorded waits, not the message count */
+    double avg_latency_us = merged.total > 0
+                            ? total_latency / (double)merged.total
+                            : 0.0;
+
+    fprintf(stderr, "\n=== AGGREGATE RESULTS (%s) ===\n",
+            g_plain ? "udp_plain" : "udp_gso");
+    fprintf(stderr, "Total bytes:  %lld\n", total_bytes);
+    fprintf(stderr, "Total msgs:   %lld\n", total_msgs);
+    fprintf(stderr, "Throughput:   %.4f Gbps\n", throughput_gbps);
+    fprintf(stderr, "Avg recv wait: %.2f us\n", avg_latency_us);
+    fprintf(stderr, "Latency percentiles: p50=%.0f p90=%.0f p99=%.0f "
+            "p99.9=%.0f max=%.0f us\n",
+            lat_hist_percentile(&merged, 50.0),
+            lat_hist_percentile(&merged, 90.0),
+            lat_hist_percentile(&merged, 99.0),
+            lat_hist_percentile(&merged, 99.9),
+            merged.max_us);
+
+    /* Machine-parseable CSV line to stdout for experiment script */
+    printf("RESULT,%s,%d,%d,%.4f,%.2f,%lld,%lld,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+           g_plain ? "udp_plain" : "udp_gso",
+           msg_size, thread_count, throughput_gbps,
+           avg_latency_us,
+           total_bytes, total_msgs,
+           lat_hist_percentile(&merged, 50.0),
+           lat_hist_percentile(&merged, 90.0),
+           lat_hist_percentile(&merged, 99.0),
+           lat_hist_percentile(&merged, 99.9),
+           merged.max_us);
+
+    free(threads);
+    free(args);
+    return 0;
+}
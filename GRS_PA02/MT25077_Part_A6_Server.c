@@ -0,0 +1,199 @@
+/* MT25077_Part_A6_Server.c - UDP Server (UDP_SEGMENT / GSO) */
+
+/*
+ * UDP counterpart to the TCP copy ladder: the telemetry-plane pattern of
+ * one datagram per message lives or dies on segmentation offload. By
+ * default the server hands the kernel 64 KB super-datagrams with
+ * UDP_SEGMENT set to the message size, so one sendto() carries dozens of
+ * messages and the kernel (or NIC) splits them; --plain sends one
+ * datagram per message as the baseline. Messages keep the 8-field
+ * 'A'+i pattern layout.
+ *
+ * Peers announce themselves with a hello datagram; each peer gets a
+ * sender thread (same thread-per-client shape as the TCP servers) with
+ * its own connect()ed socket, so ICMP unreachable stops the thread when
+ * the peer goes away.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+/* Largest UDP payload we can hand the kernel in one super-datagram */
+#define UDP_MAX_PAYLOAD 65507
+
+static volatile int g_running = 1;
+static int g_sock = -1;
+static int g_msg_size;
+static int g_plain;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+struct udp_peer_args {
+    struct sockaddr_in addr;
+};
+
+static void *peer_sender(void *arg) {
+    struct udp_peer_args *pa = (struct udp_peer_args *)arg;
+    struct sockaddr_in peer = pa->addr;
+    free(pa);
+
+    /* Own connected socket per peer: connect() makes the kernel deliver
+     * ICMP port-unreachable as ECONNREFUSED, so this thread stops when
+     * the client goes away instead of blasting into the void forever */
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        perror("socket");
+        return NULL;
+    }
+    if (connect(sock, (struct sockaddr *)&peer, sizeof(peer)) < 0) {
+        perror("connect");
+        close(sock);
+        return NULL;
+    }
+    if (!g_plain) {
+        int seg = g_msg_size;
+        if (setsockopt(sock, SOL_UDP, UDP_SEGMENT, &seg, sizeof(seg)) < 0) {
+            perror("setsockopt UDP_SEGMENT");
+        }
+    }
+
+    int field_size = g_msg_size / NUM_FIELDS;
+
+    /* Super-datagram: as many whole messages as fit in one UDP payload
+     * (just one in --plain mode) */
+    int msgs_per_send = g_plain ? 1 : UDP_MAX_PAYLOAD / g_msg_size;
+    if (msgs_per_send < 1) {
+        msgs_per_send = 1;
+    }
+    size_t send_size = (size_t)msgs_per_send * (size_t)g_msg_size;
+
+    char *buf = (char *)malloc(send_size);
+    if (!buf) {
+        perror("malloc send buffer");
+        return NULL;
+    }
+    for (int m = 0; m < msgs_per_send; m++) {
+        for (int f = 0; f < NUM_FIELDS; f++) {
+            memset(buf + (size_t)m * (size_t)g_msg_size
+                       + (size_t)f * (size_t)field_size,
+                   'A' + f, (size_t)field_size);
+        }
+    }
+
+    fprintf(stderr, "[A6-Server] peer %s:%d, %d msgs per send (%s)\n",
+            inet_ntoa(peer.sin_addr), ntohs(peer.sin_port), msgs_per_send,
+            g_plain ? "plain" : "GSO");
+
+    while (g_running) {
+        ssize_t ret = send(sock, buf, send_size, 0);
+        if (ret < 0) {
+            if (errno == EINTR || errno == ENOBUFS || errno == EAGAIN) {
+                continue;  /* transient: UDP has no backpressure contract */
+            }
+            if (errno == ECONNREFUSED) {
+                break;     /* peer closed its socket (ICMP unreachable) */
+            }
+            perror("send");
+            break;
+        }
+    }
+
+    free(buf);
+    close(sock);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--plain]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int port     = atoi(argv[1]);
+    int msg_size = atoi(argv[2]);
+    g_plain      = (argc > 3 && strcmp(argv[3], "--plain") == 0);
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0 || msg_size > UDP_MAX_PAYLOAD) {
+        fprintf(stderr, "Error: message size must be %d..%d bytes\n",
+                NUM_FIELDS, UDP_MAX_PAYLOAD);
+        return EXIT_FAILURE;
+    }
+    g_msg_size = msg_size;
+
+    install_signal_handler(SIGINT,  signal_handler);
+    install_signal_handler(SIGTERM, signal_handler);
+
+    g_sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (g_sock < 0) {
+        perror("socket");
+        return EXIT_FAILURE;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+    if (bind(g_sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("bind");
+        close(g_sock);
+        return EXIT_FAILURE;
+    }
+
+    if (!g_plain) {
+        /* Probe GSO support once so the mode banner is truthful; the
+         * per-peer sockets set their own UDP_SEGMENT */
+        int seg = msg_size;
+        if (setsockopt(g_sock, SOL_UDP, UDP_SEGMENT, &seg, sizeof(seg)) < 0) {
+            perror("setsockopt UDP_SEGMENT");
+            fprintf(stderr, "[A6-Server] GSO unavailable, falling back to "
+                    "plain datagrams\n");
+            g_plain = 1;
+        }
+    }
+
+    fprintf(stderr, "[A6-Server] UDP server (%s) listening on port %d, "
+            "msg_size=%d\n", g_plain ? "plain" : "GSO", port, msg_size);
+
+    /* Hello loop: every new datagram source gets a sender thread */
+    while (g_running) {
+        char hello[64];
+        struct sockaddr_in peer;
+        socklen_t peer_len = sizeof(peer);
+        ssize_t ret = recvfrom(g_sock, hello, sizeof(hello), 0,
+                               (struct sockaddr *)&peer, &peer_len);
+        if (ret < 0) {
+            if (!g_running) break;
+            if (errno == EINTR || errno == ECONNREFUSED) continue;
+            perror("recvfrom");
+            break;
+        }
+
+        struct udp_peer_args *pa =
+            (struct udp_peer_args *)calloc(1, sizeof(*pa));
+        pa->addr = peer;
+
+        pthread_t tid;
+        if (pthread_create(&tid, NULL, peer_sender, pa) != 0) {
+            perror("pthread_create");
+            free(pa);
+            continue;
+        }
+        pthread_detach(tid);
+    }
+
+    close(g_sock);
+    fprintf(stderr, "[A6-Server] Shutdown complete.\n");
+    return 0;
+}
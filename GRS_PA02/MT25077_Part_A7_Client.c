@@ -0,0 +1,188 @@
+/* MT25077_Part_A7_Client.c - Shared-Memory Ring Consumer */
+
+/*
+ * Consumer side of the SPSC shm ring (see MT25077_Part_A7_Server.c).
+ * Attaches to the segment named by <port>, then drains messages for the
+ * experiment duration, copying each one out of the ring (that copy is
+ * the consumer's entire receive path) and advancing head with a release
+ * store. Strictly single-consumer: the ring has one head index, so
+ * thread_count is pinned to 1. The server_ip argument is accepted for
+ * CLI compatibility and ignored - shared memory does not route.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define SHM_RING_BYTES (8 * 1024 * 1024)
+
+struct shm_ring {
+    _Atomic unsigned long long head __attribute__((aligned(64)));
+    _Atomic unsigned long long tail __attribute__((aligned(64)));
+    _Atomic int client_attached __attribute__((aligned(64)));
+    _Atomic int futex_mode;
+    int msg_size;
+    char data[] __attribute__((aligned(64)));
+};
+
+static int sys_futex(void *addr, int op, int val) {
+    return (int)syscall(__NR_futex, addr, op, val, NULL, NULL, 0);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5) {
+        fprintf(stderr,
+                "Usage: %s <server_ip> <port> <msg_size> <thread_count> "
+                "[duration_s]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int port         = atoi(argv[2]);
+    int msg_size     = atoi(argv[3]);
+    int thread_count = atoi(argv[4]);
+    int duration     = (argc > 5) ? atoi(argv[5]) : DEFAULT_DURATION;
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0) {
+        fprintf(stderr, "Error: message size must be >= %d bytes\n", NUM_FIELDS);
+        return EXIT_FAILURE;
+    }
+    if (thread_count != 1) {
+        fprintf(stderr, "[A7-Client] SPSC ring: forcing thread_count 1\n");
+        thread_count = 1;
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "/mt25077_ring_%d", port);
+
+    /* The server may still be creating the segment */
+    int fd = -1;
+    for (int i = 0; i < 200 && fd < 0; i++) {
+        fd = shm_open(name, O_RDWR, 0);
+        if (fd < 0) {
+            usleep(10000);
+        }
+    }
+    if (fd < 0) {
+        perror("shm_open");
+        return EXIT_FAILURE;
+    }
+
+    size_t total = sizeof(struct shm_ring) + SHM_RING_BYTES;
+    struct shm_ring *ring = (struct shm_ring *)
+        mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ring == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    if (ring->msg_size != msg_size) {
+        fprintf(stderr, "Error: ring carries msg_size=%d, client asked %d\n",
+                ring->msg_size, msg_size);
+        munmap(ring, total);
+        return EXIT_FAILURE;
+    }
+    int futex_mode = atomic_load(&ring->futex_mode);
+
+    fprintf(stderr, "[A7-Client] shm_ring: segment=%s msg_size=%d "
+            "duration=%ds (%s)\n", name, msg_size, duration,
+            futex_mode ? "futex" : "busy-poll");
+
+    char *out_buf = (char *)malloc((size_t)msg_size);
+    if (!out_buf) {
+        munmap(ring, total);
+        return EXIT_FAILURE;
+    }
+
+    struct lat_hist hist;
+    memset(&hist, 0, sizeof(hist));
+    double total_wait_us = 0.0;
+
+    atomic_store(&ring->client_attached, 1);
+
+    double start_time = get_time_us();
+    double end_time = start_time + (double)duration * 1e6;
+    unsigned long long head = atomic_load(&ring->head);
+    long long bytes = 0, msgs = 0;
+
+    while (get_time_us() < end_time) {
+        double wait_start = get_time_us();
+        unsigned long long tail =
+            atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+        if (head == tail) {
+            if (futex_mode) {
+                /* Sleep until the producer publishes and wakes us; the
+                 * futex word is the low half of tail (little-endian) */
+                sys_futex((void *)&ring->tail, FUTEX_WAIT,
+                          (int)(unsigned)tail);
+            }
+            /* Busy-poll mode just spins back to the acquire load */
+            continue;
+        }
+        double waited_us = get_time_us() - wait_start;
+        lat_hist_record(&hist, waited_us);
+        total_wait_us += waited_us;
+
+        while (head != tail && get_time_us() < end_time) {
+            size_t off = (size_t)(head % SHM_RING_BYTES);
+            if (off + (size_t)msg_size > SHM_RING_BYTES) {
+                /* Producer skipped the tail fragment; do the same */
+                head += SHM_RING_BYTES - off;
+                continue;
+            }
+
+            /* The receive copy: ring slot -> private buffer */
+            memcpy(out_buf, ring->data + off, (size_t)msg_size);
+            head += (unsigned long long)msg_size;
+            bytes += msg_size;
+            msgs++;
+
+            /* Free the slot for the producer */
+            atomic_store_explicit(&ring->head, head, memory_order_release);
+        }
+    }
+
+    double elapsed_s = (get_time_us() - start_time) / 1e6;
+    double throughput_gbps = (bytes * 8.0) / ((double)duration * 1e9);
+
+    /* Per-message latency is not defined for a shared-memory ring; the
+     * comparable figure is the mean ring-empty wait per non-empty
+     * observation, which is what the histogram samples */
+    double avg_wait_us = hist.total > 0
+                         ? total_wait_us / (double)hist.total
+                         : 0.0;
+
+    fprintf(stderr, "\n=== AGGREGATE RESULTS (shm_ring) ===\n");
+    fprintf(stderr, "Total bytes:  %lld\n", bytes);
+    fprintf(stderr, "Total msgs:   %lld\n", msgs);
+    fprintf(stderr, "Throughput:   %.4f Gbps (%.2f MB in %.2f s)\n",
+            throughput_gbps, bytes / (1024.0 * 1024.0), elapsed_s);
+    fprintf(stderr, "Avg ring-empty wait: %.2f us\n", avg_wait_us);
+    fprintf(stderr, "Latency percentiles: p50=%.0f p90=%.0f p99=%.0f "
+            "p99.9=%.0f max=%.0f us (ring-empty waits)\n",
+            lat_hist_percentile(&hist, 50.0),
+            lat_hist_percentile(&hist, 90.0),
+            lat_hist_percentile(&hist, 99.0),
+            lat_hist_percentile(&hist, 99.9),
+            hist.max_us);
+
+    /* Machine-parseable CSV line to stdout for experiment script */
+    printf("RESULT,shm_ring,%d,%d,%.4f,%.2f,%lld,%lld,%.0f,%.0f,%.0f,%.0f,%.0f\n",
+           msg_size, thread_count, throughput_gbps,
+           avg_wait_us,
+           bytes, msgs,
+           lat_hist_percentile(&hist, 50.0),
+           lat_hist_percentile(&hist, 90.0),
+           lat_hist_percentile(&hist, 99.0),
+           lat_hist_percentile(&hist, 99.9),
+           hist.max_us);
+
+    free(out_buf);
+    munmap(ring, total);
+    return 0;
+}
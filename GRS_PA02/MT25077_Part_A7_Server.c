@@ -0,0 +1,180 @@
+/* MT25077_Part_A7_Server.c - Shared-Memory Ring Producer (loopback floor) */
+
+/*
+ * The intra-host ceiling for the copy ladder: "server" and "client"
+ * exchange the same 8-field messages through an mmap'd single-producer/
+ * single-consumer ring buffer - no sockets, no syscalls on the hot path.
+ * head and tail live on their own cache lines and are published with
+ * release stores / consumed with acquire loads, so the only traffic
+ * between the two processes is the payload itself plus two cache lines
+ * of indices. Whatever gap remains between this and A1-A5 on the same
+ * plots is the TCP stack, not copies.
+ *
+ * The consumer busy-polls by default; --futex switches it to
+ * futex-wait/wake so idle rings cost no CPU (the producer wakes it
+ * after each publish batch). The <port> argument names the shm segment
+ * so the usual port/msg_size CLI conventions hold.
+ */
+
+#include "MT25077_Part_A_Common.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define SHM_RING_BYTES (8 * 1024 * 1024)   /* power of two, well over LLC */
+
+/* Ring header: indices on dedicated cache lines, then the data area */
+struct shm_ring {
+    _Atomic unsigned long long head __attribute__((aligned(64)));  /* consumer */
+    _Atomic unsigned long long tail __attribute__((aligned(64)));  /* producer */
+    _Atomic int client_attached __attribute__((aligned(64)));
+    _Atomic int futex_mode;
+    int msg_size;
+    char data[] __attribute__((aligned(64)));
+};
+
+static volatile int g_running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    g_running = 0;
+}
+
+static void shm_ring_name(char *buf, size_t len, int port) {
+    snprintf(buf, len, "/mt25077_ring_%d", port);
+}
+
+static int sys_futex(void *addr, int op, int val) {
+    return (int)syscall(__NR_futex, addr, op, val, NULL, NULL, 0);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <port> <message_size_bytes> [--futex]\n",
+                argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    int port     = atoi(argv[1]);
+    int msg_size = atoi(argv[2]);
+    int futex_mode = (argc > 3 && strcmp(argv[3], "--futex") == 0);
+
+    msg_size = (msg_size / NUM_FIELDS) * NUM_FIELDS;
+    if (msg_size == 0 || msg_size > SHM_RING_BYTES / 4) {
+        fprintf(stderr, "Error: message size must be %d..%d bytes\n",
+                NUM_FIELDS, SHM_RING_BYTES / 4);
+        return EXIT_FAILURE;
+    }
+    int field_size = msg_size / NUM_FIELDS;
+
+    install_signal_handler(SIGINT,  signal_handler);
+    install_signal_handler(SIGTERM, signal_handler);
+
+    char name[64];
+    shm_ring_name(name, sizeof(name), port);
+    shm_unlink(name);  /* stale segment from a crashed run */
+
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("shm_open");
+        return EXIT_FAILURE;
+    }
+    size_t total = sizeof(struct shm_ring) + SHM_RING_BYTES;
+    if (ftruncate(fd, (off_t)total) != 0) {
+        perror("ftruncate");
+        shm_unlink(name);
+        return EXIT_FAILURE;
+    }
+
+    struct shm_ring *ring = (struct shm_ring *)
+        mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (ring == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(name);
+        return EXIT_FAILURE;
+    }
+    close(fd);
+
+    atomic_store(&ring->head, 0);
+    atomic_store(&ring->tail, 0);
+    atomic_store(&ring->client_attached, 0);
+    atomic_store(&ring->futex_mode, futex_mode);
+    ring->msg_size = msg_size;
+
+    /* One message in the usual 8-field pattern, copied into ring slots */
+    char *msg_buf = (char *)malloc((size_t)msg_size);
+    if (!msg_buf) {
+        shm_unlink(name);
+        return EXIT_FAILURE;
+    }
+    for (int f = 0; f < NUM_FIELDS; f++) {
+        memset(msg_buf + (size_t)f * (size_t)field_size, 'A' + f,
+               (size_t)field_size);
+    }
+
+    fprintf(stderr, "[A7-Server] shm ring '%s', msg_size=%d, ring=%d KB, "
+            "%s wakeups\n", name, msg_size, SHM_RING_BYTES / 1024,
+            futex_mode ? "futex" : "busy-poll");
+
+    /* Wait for the consumer to attach */
+    while (g_running && !atomic_load(&ring->client_attached)) {
+        usleep(10000);
+    }
+
+    unsigned long long tail = atomic_load(&ring->tail);
+    long long published = 0;
+
+    /* Wake cadence must never exceed what the ring can hold, or the
+     * producer blocks on a full ring before the wake the sleeping
+     * consumer is waiting for (64 is just batching for small messages) */
+    long long wake_every = 64;
+    long long ring_msgs = SHM_RING_BYTES / msg_size;
+    if (wake_every > ring_msgs / 2) {
+        wake_every = ring_msgs / 2 > 0 ? ring_msgs / 2 : 1;
+    }
+
+    while (g_running) {
+        /* Wait for ring space (consumer is usually the fast side) */
+        unsigned long long head =
+            atomic_load_explicit(&ring->head, memory_order_acquire);
+        if (tail - head > (unsigned long long)(SHM_RING_BYTES - msg_size)) {
+            /* Full: brief pause; the consumer drains quickly */
+            usleep(100);
+            continue;
+        }
+
+        /* Messages never straddle the wrap: when the remaining space at
+         * the end of the ring cannot hold a whole message, both sides
+         * skip it and continue from offset zero */
+        size_t off = (size_t)(tail % SHM_RING_BYTES);
+        if (off + (size_t)msg_size > SHM_RING_BYTES) {
+            /* Skip the tail fragment so a message never wraps; the
+             * consumer performs the same rounding */
+            tail += SHM_RING_BYTES - off;
+            continue;
+        }
+        memcpy(ring->data + off, msg_buf, (size_t)msg_size);
+
+        /* Publish: payload first, then the index that makes it visible */
+        tail += (unsigned long long)msg_size;
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+        published++;
+
+        if (futex_mode && published % wake_every == 0) {
+            sys_futex((void *)&ring->tail, FUTEX_WAKE, 1);
+        }
+    }
+
+    /* Final wake so a futex-parked consumer notices shutdown */
+    if (futex_mode) {
+        sys_futex((void *)&ring->tail, FUTEX_WAKE, 1);
+    }
+
+    fprintf(stderr, "[A7-Server] published %lld messages; shutdown.\n",
+            published);
+    free(msg_buf);
+    munmap(ring, total);
+    shm_unlink(name);
+    return 0;
+}
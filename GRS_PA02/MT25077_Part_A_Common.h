@@ -19,6 +19,12 @@
 #include <time.h>
 #include <errno.h>
 #include <poll.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+#include <stdatomic.h>
 
 #define NUM_FIELDS        8   /* 8 dynamically allocated string fields per message */
 #define DEFAULT_PORT      9000
@@ -35,6 +41,80 @@ struct server_thread_args {
     int    field_size;
 };
 
+/* ============================================================
+ * Fixed-memory latency histogram (HDR-style log-linear buckets)
+ *
+ * The clients used to report only a mean latency, which hides exactly
+ * the tail (p99/p99.9) that zero-copy's ENOBUFS stalls land in. The
+ * histogram uses 1 us buckets below 1024 us and 32 log-linear
+ * sub-buckets per power of two above that, bounding relative error to
+ * ~3% with a few KB of fixed memory per thread. Per-thread histograms
+ * merge by bucket addition after join.
+ * ============================================================ */
+
+#define LAT_HIST_LINEAR   1024                 /* 1 us buckets below 1 ms */
+#define LAT_HIST_SUBBITS  5                    /* 32 sub-buckets per octave */
+#define LAT_HIST_BUCKETS  (LAT_HIST_LINEAR + 21 * (1 << LAT_HIST_SUBBITS))
+
+struct lat_hist {
+    long long counts[LAT_HIST_BUCKETS];
+    long long total;
+    double    max_us;
+};
+
+static inline int lat_hist_bucket(long long us) {
+    if (us < 0) us = 0;
+    if (us < LAT_HIST_LINEAR) {
+        return (int)us;
+    }
+    int msb = 63 - __builtin_clzll((unsigned long long)us);
+    int sub = (int)((us >> (msb - LAT_HIST_SUBBITS)) & ((1 << LAT_HIST_SUBBITS) - 1));
+    int idx = LAT_HIST_LINEAR + (msb - 10) * (1 << LAT_HIST_SUBBITS) + sub;
+    if (idx >= LAT_HIST_BUCKETS) idx = LAT_HIST_BUCKETS - 1;
+    return idx;
+}
+
+/* Lower bound of a bucket in microseconds (for percentile readout) */
+static inline double lat_hist_bucket_value(int idx) {
+    if (idx < LAT_HIST_LINEAR) {
+        return (double)idx;
+    }
+    int msb = 10 + (idx - LAT_HIST_LINEAR) / (1 << LAT_HIST_SUBBITS);
+    int sub = (idx - LAT_HIST_LINEAR) % (1 << LAT_HIST_SUBBITS);
+    return (double)((1LL << msb)
+                    + ((long long)sub << (msb - LAT_HIST_SUBBITS)));
+}
+
+static inline void lat_hist_record(struct lat_hist *h, double us) {
+    h->counts[lat_hist_bucket((long long)us)]++;
+    h->total++;
+    if (us > h->max_us) h->max_us = us;
+}
+
+static inline void lat_hist_merge(struct lat_hist *into,
+                                  const struct lat_hist *from) {
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+        into->counts[i] += from->counts[i];
+    }
+    into->total += from->total;
+    if (from->max_us > into->max_us) into->max_us = from->max_us;
+}
+
+/* pct in [0,100]; returns the bucket lower bound holding that rank */
+static inline double lat_hist_percentile(const struct lat_hist *h, double pct) {
+    if (h->total == 0) return 0.0;
+    long long rank = (long long)(pct / 100.0 * (double)h->total + 0.5);
+    if (rank < 1) rank = 1;
+    long long seen = 0;
+    for (int i = 0; i < LAT_HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            return lat_hist_bucket_value(i);
+        }
+    }
+    return h->max_us;
+}
+
 struct client_thread_args {
     const char *server_ip;
     int         port;
@@ -45,8 +125,81 @@ struct client_thread_args {
     long long   bytes_received;
     long long   messages_received;
     double      total_latency_us;
+    struct lat_hist hist;
+    /* Scatter-gather receive mode (--sg) */
+    int         sg_mode;
+    long long   verify_errors;   /* fields whose pattern check failed */
+    double      cpu_time_s;      /* thread CPU time spent in the loop */
+    /* Multi-connection epoll mode (--conns), 0 = one blocking socket */
+    int         mc_conns;
+    long        mc_rate;         /* per-connection msgs/sec cap, 0 = none */
+    /* Kernel/hardware timestamping mode (--ts) */
+    int         ts_mode;
+    struct lat_hist ts_hist;     /* kernel-receive -> userspace deltas */
+    long long   ts_samples;
+    long long   hw_samples;      /* recvs that carried a NIC timestamp */
 };
 
+/* ============================================================
+ * Kernel/hardware receive timestamping (--ts)
+ *
+ * get_time_us() around recv_all() measures how long the client slept,
+ * not how long the network took: scheduling wakeup latency is folded
+ * into every sample. SO_TIMESTAMPING attaches the kernel's (and, where
+ * the NIC supports it, the hardware's) receive timestamp to the data as
+ * a control message, so the kernel-receive -> userspace delta can be
+ * separated from wire time.
+ * ============================================================ */
+
+static inline int ts_enable(int fd) {
+    int flags = SOF_TIMESTAMPING_RX_SOFTWARE
+                | SOF_TIMESTAMPING_SOFTWARE
+                | SOF_TIMESTAMPING_RX_HARDWARE
+                | SOF_TIMESTAMPING_RAW_HARDWARE;
+    if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) < 0) {
+        /* Retry software-only: hardware flags fail on NICs without it */
+        flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+        return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPING,
+                          &flags, sizeof(flags));
+    }
+    return 0;
+}
+
+/*
+ * Pull the receive timestamp out of a recvmsg() control buffer and
+ * return the kernel-receive -> now delta in microseconds from the
+ * *software* stamp, which shares the CLOCK_REALTIME domain with the
+ * comparison read. The raw hardware stamp (ts[2]) lives in the NIC's
+ * PHC clock domain: without the PHC-to-realtime offset it cannot be
+ * differenced against CLOCK_REALTIME, so its presence is only reported
+ * through *has_hw (a wire->app decomposition needs the PHC offset from
+ * ptp4l/phc2sys and stays out of the kernel->user histogram).
+ * Returns a negative value when no software stamp was attached.
+ */
+static inline double ts_extract_delta_us(struct msghdr *mh, int *has_hw) {
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(mh); cm != NULL;
+         cm = CMSG_NXTHDR(mh, cm)) {
+        if (cm->cmsg_level != SOL_SOCKET || cm->cmsg_type != SCM_TIMESTAMPING) {
+            continue;
+        }
+        struct scm_timestamping *ts = (struct scm_timestamping *)CMSG_DATA(cm);
+
+        /* ts[2] = raw hardware (PHC domain), ts[0] = software (realtime) */
+        if (ts->ts[2].tv_sec != 0 || ts->ts[2].tv_nsec != 0) {
+            *has_hw = 1;
+        }
+        if (ts->ts[0].tv_sec == 0 && ts->ts[0].tv_nsec == 0) {
+            return -1.0;  /* hardware-only stamp: no comparable delta */
+        }
+
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        return (double)(now.tv_sec - ts->ts[0].tv_sec) * 1e6
+               + (double)(now.tv_nsec - ts->ts[0].tv_nsec) / 1e3;
+    }
+    return -1.0;
+}
+
 /* Returns monotonic time in microseconds */
 static inline double get_time_us(void) {
     struct timespec ts;
@@ -83,6 +236,82 @@ static inline void free_message(struct message *msg) {
     free(msg);
 }
 
+/* ============================================================
+ * Slab allocator for struct message
+ *
+ * alloc_message() costs 9 mallocs and scatters the 8 fields wherever the
+ * heap puts them, so every iovec gather walks 8 unrelated cache lines
+ * before the kernel sees a byte. The slab carves the message header and
+ * all NUM_FIELDS fields out of one 64-byte-aligned contiguous block -
+ * fields end up adjacent, which changes the cache behavior of every send
+ * loop (exactly the memory-copy effect PA02 isolates) - and recycles
+ * freed blocks through a thread-local free list, so reconnect churn
+ * stops paying allocator cost. msg_size is constant within a run, which
+ * is what makes the single-size free list sufficient.
+ * ============================================================ */
+
+/* Process-wide single-size free list, chained through the block head.
+ * A thread-local list would leak blocks freed by thread-per-connection
+ * handlers, whose threads exit right after the free; the mutex is taken
+ * once per connection setup/teardown, so contention is negligible. */
+static void *slab_free_list;
+static int   slab_free_msg_size;
+static pthread_mutex_t slab_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Bytes reserved for struct message at the head of a block, padded so
+ * field 0 starts on its own cache line */
+#define SLAB_HEADER_SIZE ((sizeof(struct message) + 63) & ~(size_t)63)
+
+static inline struct message *alloc_message_slab(int msg_size) {
+    int field_size = msg_size / NUM_FIELDS;
+    void *block = NULL;
+
+    pthread_mutex_lock(&slab_lock);
+    if (slab_free_list != NULL && slab_free_msg_size != msg_size) {
+        /* Size changed mid-process: the cached blocks are the wrong
+         * size, so hand them back to the heap instead of letting a
+         * later pop overflow a smaller block */
+        while (slab_free_list != NULL) {
+            void *stale = slab_free_list;
+            slab_free_list = *(void **)stale;
+            free(stale);
+        }
+    }
+    if (slab_free_list != NULL) {
+        block = slab_free_list;
+        slab_free_list = *(void **)block;
+    }
+    slab_free_msg_size = msg_size;
+    pthread_mutex_unlock(&slab_lock);
+
+    if (block == NULL) {
+        size_t block_size =
+            (SLAB_HEADER_SIZE + (size_t)msg_size + 63) & ~(size_t)63;
+        block = aligned_alloc(64, block_size);
+        if (!block) {
+            perror("aligned_alloc message slab");
+            return NULL;
+        }
+    }
+
+    struct message *msg = (struct message *)block;
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        msg->fields[i] = (char *)block + SLAB_HEADER_SIZE
+                         + (size_t)i * (size_t)field_size;
+        memset(msg->fields[i], 'A' + i, (size_t)field_size);
+    }
+    return msg;
+}
+
+static inline void free_message_slab(struct message *msg) {
+    if (!msg) return;
+    /* Chain the block through its first word; the pattern data is dead */
+    pthread_mutex_lock(&slab_lock);
+    *(void **)msg = slab_free_list;
+    slab_free_list = msg;
+    pthread_mutex_unlock(&slab_lock);
+}
+
 /* Send exactly len bytes, handling partial sends */
 static inline ssize_t send_all(int fd, const void *buf, size_t len) {
     size_t total = 0;
@@ -94,6 +323,31 @@ static inline ssize_t send_all(int fd, const void *buf, size_t len) {
     return (ssize_t)total;
 }
 
+/* Receive exactly 'total' bytes into a scatter list, handling partial
+ * reads by advancing through the iovecs. The iov array is modified. */
+static inline ssize_t recv_all_vec(int fd, struct iovec *iov, int iovcnt,
+                                   size_t total) {
+    size_t received = 0;
+    int idx = 0;
+    while (received < total && idx < iovcnt) {
+        ssize_t n = readv(fd, iov + idx, iovcnt - idx);
+        if (n <= 0) return n;
+        received += (size_t)n;
+
+        /* Advance past fully and partially consumed iovecs */
+        size_t consumed = (size_t)n;
+        while (idx < iovcnt && consumed >= iov[idx].iov_len) {
+            consumed -= iov[idx].iov_len;
+            idx++;
+        }
+        if (idx < iovcnt && consumed > 0) {
+            iov[idx].iov_base = (char *)iov[idx].iov_base + consumed;
+            iov[idx].iov_len -= consumed;
+        }
+    }
+    return (ssize_t)received;
+}
+
 /* Receive exactly len bytes, handling partial reads */
 static inline ssize_t recv_all(int fd, void *buf, size_t len) {
     size_t total = 0;
@@ -178,4 +432,822 @@ static inline int connect_to_server(const char *server_ip, int port) {
     return fd;
 }
 
+/* ============================================================
+ * Event-loop server engine (--epoll mode)
+ *
+ * The thread-per-connection servers collapse around a few thousand
+ * clients from stack memory and context switches alone. In epoll mode a
+ * small fixed set of worker loops (default: one per online CPU) own all
+ * connections: loop 0 also owns the listen socket and hands each
+ * accepted connection to a loop round-robin. Connections are
+ * non-blocking and armed level-triggered for EPOLLOUT; when writable,
+ * the implementation-specific send callback runs until it would block.
+ * The same engine serves all three copy strategies - only the send
+ * callback differs.
+ * ============================================================ */
+
+#define EPOLL_MAX_EVENTS 64
+
+/* Per-connection server statistics (defined with the stats module below;
+ * the engine acquires a slot per connection and records around sends) */
+struct srv_conn_stats;
+static inline struct srv_conn_stats *srv_stats_acquire(void);
+static inline void srv_stats_release(struct srv_conn_stats *st);
+static inline void srv_stats_record(struct srv_conn_stats *st,
+                                    long long bytes, double latency_us);
+static inline void srv_stats_record_err(struct srv_conn_stats *st, int err);
+
+/*
+ * Send pacing (--pace R [--lowat B]). The firehose send loops keep the
+ * socket buffers saturated, so every queued byte inflates the client's
+ * observed latency and the throughput/latency trade-off is unmeasurable.
+ * With pacing, TCP_NOTSENT_LOWAT caps the unsent in-flight bytes per
+ * connection (EPOLLOUT only fires when the unsent queue drops below the
+ * watermark) and a per-connection token allowance caps the send rate: a
+ * spent connection is de-armed from the interest set until the
+ * one-second refill tick. Set by the servers before run_epoll_server().
+ */
+static int g_epoll_pace_rate;     /* msgs/sec per connection, 0 = firehose */
+static int g_epoll_notsent_lowat; /* TCP_NOTSENT_LOWAT bytes, 0 = default */
+
+/* Per-connection state shared by all server implementations */
+struct epoll_conn {
+    int    fd;
+    int    msg_size;
+    int    field_size;
+    struct message *msg;
+    char  *send_buf;              /* two-copy only: serialization buffer */
+    size_t send_offset;           /* bytes of the current message sent */
+    long long send_count;         /* sends since connect (zero-copy drain) */
+    struct srv_conn_stats *stats; /* live-telemetry slot, NULL if exhausted */
+    /* Pacing state */
+    long long allowance;          /* bytes this connection may still send */
+    int       armed;              /* registered for EPOLLOUT right now */
+    struct epoll_conn *next;      /* loop's connection list (for refills) */
+};
+
+/*
+ * Implementation-specific send step. Returns:
+ *   > 0  bytes queued (keep going while writable)
+ *   == 0 would block or transient backpressure (wait for EPOLLOUT again)
+ *   < 0  fatal error (connection is torn down)
+ */
+typedef ssize_t (*epoll_send_fn)(struct epoll_conn *conn);
+
+static inline int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return -1;
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+/* One event loop's state */
+struct epoll_loop {
+    int epfd;
+    int listen_fd;                /* -1 on loops that do not accept */
+    int msg_size;
+    int field_size;
+    epoll_send_fn send_fn;
+    volatile int *running;
+    /* Accept distribution (loop 0 only) */
+    struct epoll_loop *loops;
+    int num_loops;
+    int next_loop;
+    /* Pacing: connections owned by this loop, refilled once per second.
+     * The lock covers list membership only - loop 0's accept path links
+     * new connections into other loops' lists */
+    struct epoll_conn *conns;
+    pthread_mutex_t conns_lock;
+    double last_refill_us;
+};
+
+static inline struct epoll_conn *epoll_conn_create(int fd, int msg_size,
+                                                   int field_size) {
+    struct epoll_conn *conn =
+        (struct epoll_conn *)calloc(1, sizeof(struct epoll_conn));
+    if (!conn) return NULL;
+
+    conn->fd = fd;
+    conn->msg_size = msg_size;
+    conn->field_size = field_size;
+    conn->msg = alloc_message_slab(msg_size);
+    if (!conn->msg) {
+        free(conn);
+        return NULL;
+    }
+    conn->stats = srv_stats_acquire();
+
+    /* send_buf stays NULL here: only the two-copy implementation needs a
+     * serialization buffer, and it allocates one lazily on first send */
+
+    return conn;
+}
+
+/*
+ * Build iovecs covering the unsent remainder of the current message
+ * (conn->send_offset bytes already left on a previous partial send).
+ * Restarting a message from field 0 after a short write on the
+ * non-blocking socket would permanently shift the stream framing, so
+ * the send callbacks always resume exactly where the kernel stopped.
+ * Returns the number of iovecs filled.
+ */
+static inline int epoll_iov_from_offset(struct epoll_conn *conn,
+                                        struct iovec *iov) {
+    size_t skip = conn->send_offset;
+    int n = 0;
+    for (int i = 0; i < NUM_FIELDS; i++) {
+        size_t len = (size_t)conn->field_size;
+        if (skip >= len) {
+            skip -= len;
+            continue;
+        }
+        iov[n].iov_base = (char *)conn->msg->fields[i] + skip;
+        iov[n].iov_len  = len - skip;
+        skip = 0;
+        n++;
+    }
+    return n;
+}
+
+/*
+ * Account 'sent' bytes of the current message; resets the offset once
+ * the whole message is out so the next call starts the next message.
+ */
+static inline void epoll_conn_advance(struct epoll_conn *conn, ssize_t sent) {
+    conn->send_offset += (size_t)sent;
+    if (conn->send_offset >= (size_t)conn->msg_size) {
+        conn->send_offset = 0;
+    }
+}
+
+static inline void epoll_conn_destroy(struct epoll_loop *loop,
+                                      struct epoll_conn *conn) {
+    /* Unlink from the loop's pacing list */
+    pthread_mutex_lock(&loop->conns_lock);
+    struct epoll_conn **pp = &loop->conns;
+    while (*pp != NULL && *pp != conn) {
+        pp = &(*pp)->next;
+    }
+    if (*pp == conn) {
+        *pp = conn->next;
+    }
+    pthread_mutex_unlock(&loop->conns_lock);
+
+    srv_stats_release(conn->stats);
+
+    epoll_ctl(loop->epfd, EPOLL_CTL_DEL, conn->fd, NULL);
+    close(conn->fd);
+    free(conn->send_buf);
+    free_message_slab(conn->msg);
+    free(conn);
+}
+
+/* Accept as many pending connections as the listen queue holds and
+ * spread them round-robin over the loops */
+static inline void epoll_accept_burst(struct epoll_loop *loop) {
+    for (;;) {
+        int client_fd = accept(loop->listen_fd, NULL, NULL);
+        if (client_fd < 0) {
+            break;  /* EAGAIN: queue drained (or EINTR on shutdown) */
+        }
+
+        int flag = 1;
+        setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+        if (set_nonblocking(client_fd) != 0) {
+            close(client_fd);
+            continue;
+        }
+
+        struct epoll_conn *conn =
+            epoll_conn_create(client_fd, loop->msg_size, loop->field_size);
+        if (!conn) {
+            close(client_fd);
+            continue;
+        }
+
+        if (g_epoll_notsent_lowat > 0) {
+            setsockopt(client_fd, IPPROTO_TCP, TCP_NOTSENT_LOWAT,
+                       &g_epoll_notsent_lowat, sizeof(g_epoll_notsent_lowat));
+        }
+        if (g_epoll_pace_rate > 0) {
+            conn->allowance =
+                (long long)g_epoll_pace_rate * loop->msg_size;
+        }
+        conn->armed = 1;
+
+        struct epoll_loop *target =
+            &loop->loops[loop->next_loop % loop->num_loops];
+        loop->next_loop++;
+
+        /* Link into the target's list BEFORE registering the fd: once
+         * EPOLL_CTL_ADD lands, the target loop may destroy the conn on a
+         * peer reset, and a link made afterwards would insert freed
+         * memory into the pacing list */
+        pthread_mutex_lock(&target->conns_lock);
+        conn->next = target->conns;
+        target->conns = conn;
+        pthread_mutex_unlock(&target->conns_lock);
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLOUT;
+        ev.data.ptr = conn;
+        if (epoll_ctl(target->epfd, EPOLL_CTL_ADD, client_fd, &ev) != 0) {
+            perror("epoll_ctl add connection");
+            epoll_conn_destroy(target, conn);  /* also unlinks */
+            continue;
+        }
+    }
+}
+
+/* Body of one event loop; also the pthread entry point */
+static inline void *epoll_loop_run(void *arg) {
+    struct epoll_loop *loop = (struct epoll_loop *)arg;
+    struct epoll_event events[EPOLL_MAX_EVENTS];
+
+    while (*loop->running) {
+        int n = epoll_wait(loop->epfd, events, EPOLL_MAX_EVENTS, 200);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int e = 0; e < n; e++) {
+            if (events[e].data.ptr == NULL) {
+                /* Listen socket (loop 0 only) */
+                epoll_accept_burst(loop);
+                continue;
+            }
+
+            struct epoll_conn *conn = (struct epoll_conn *)events[e].data.ptr;
+            if (events[e].events & EPOLLHUP) {
+                epoll_conn_destroy(loop, conn);
+                continue;
+            }
+            /* EPOLLERR alone is not fatal here: pending error-queue data
+             * (zero-copy completions) raises it too. The send callback
+             * returns < 0 on real socket errors, which tears down below. */
+
+            /* Writable: push until the socket buffer fills (or, when
+             * paced, until this second's allowance is spent) */
+            for (;;) {
+                double send_t0 = get_time_us();
+                ssize_t ret = loop->send_fn(conn);
+                if (ret > 0) {
+                    srv_stats_record(conn->stats, ret,
+                                     get_time_us() - send_t0);
+                    if (g_epoll_pace_rate > 0) {
+                        conn->allowance -= ret;
+                        if (conn->allowance <= 0) {
+                            struct epoll_event dev;
+                            memset(&dev, 0, sizeof(dev));
+                            dev.data.ptr = conn;
+                            dev.events = 0;
+                            epoll_ctl(loop->epfd, EPOLL_CTL_MOD, conn->fd,
+                                      &dev);
+                            conn->armed = 0;
+                            break;
+                        }
+                    }
+                    continue;
+                }
+                if (ret == 0) break;        /* EAGAIN: wait for EPOLLOUT */
+                epoll_conn_destroy(loop, conn);
+                break;
+            }
+        }
+
+        /* Pacing refill: once a second, top up every connection and
+         * re-arm the ones that ran dry */
+        if (g_epoll_pace_rate > 0) {
+            double now = get_time_us();
+            if (loop->last_refill_us == 0.0) {
+                loop->last_refill_us = now;
+            } else if (now - loop->last_refill_us >= 1e6) {
+                loop->last_refill_us = now;
+                pthread_mutex_lock(&loop->conns_lock);
+                for (struct epoll_conn *c = loop->conns; c != NULL;
+                     c = c->next) {
+                    c->allowance =
+                        (long long)g_epoll_pace_rate * loop->msg_size;
+                    if (!c->armed) {
+                        struct epoll_event ev;
+                        memset(&ev, 0, sizeof(ev));
+                        ev.data.ptr = c;
+                        ev.events = EPOLLOUT;
+                        epoll_ctl(loop->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+                        c->armed = 1;
+                    }
+                }
+                pthread_mutex_unlock(&loop->conns_lock);
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Run the event-loop server: num_loops loops (0 = one per online CPU),
+ * loop 0 accepting from server_fd. Blocks until *running drops.
+ */
+static inline int run_epoll_server(int server_fd, int msg_size,
+                                   int num_loops, epoll_send_fn send_fn,
+                                   volatile int *running) {
+    if (num_loops <= 0) {
+        num_loops = (int)sysconf(_SC_NPROCESSORS_ONLN);
+        if (num_loops < 1) num_loops = 1;
+    }
+
+    struct epoll_loop *loops =
+        (struct epoll_loop *)calloc((size_t)num_loops, sizeof(*loops));
+    if (!loops) return -1;
+
+    for (int i = 0; i < num_loops; i++) {
+        loops[i].epfd = epoll_create1(0);
+        if (loops[i].epfd < 0) {
+            perror("epoll_create1");
+            return -1;
+        }
+        loops[i].listen_fd = (i == 0) ? server_fd : -1;
+        pthread_mutex_init(&loops[i].conns_lock, NULL);
+        loops[i].msg_size = msg_size;
+        loops[i].field_size = msg_size / NUM_FIELDS;
+        loops[i].send_fn = send_fn;
+        loops[i].running = running;
+        loops[i].loops = loops;
+        loops[i].num_loops = num_loops;
+    }
+
+    /* Non-blocking listen socket in loop 0, tagged with NULL data.ptr */
+    set_nonblocking(server_fd);
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(loops[0].epfd, EPOLL_CTL_ADD, server_fd, &ev) != 0) {
+        perror("epoll_ctl add listen");
+        return -1;
+    }
+
+    if (g_epoll_pace_rate > 0 || g_epoll_notsent_lowat > 0) {
+        fprintf(stderr, "[epoll] pacing: %d msgs/sec/conn, "
+                "TCP_NOTSENT_LOWAT=%d\n",
+                g_epoll_pace_rate, g_epoll_notsent_lowat);
+    }
+    fprintf(stderr, "[epoll] %d event loop(s), level-triggered EPOLLOUT\n",
+            num_loops);
+
+    pthread_t *tids =
+        (pthread_t *)malloc(sizeof(pthread_t) * (size_t)(num_loops - 1));
+    for (int i = 1; i < num_loops; i++) {
+        pthread_create(&tids[i - 1], NULL, epoll_loop_run, &loops[i]);
+    }
+    epoll_loop_run(&loops[0]);  /* main thread drives loop 0 */
+
+    for (int i = 1; i < num_loops; i++) {
+        pthread_join(tids[i - 1], NULL);
+    }
+    free(tids);
+    for (int i = 0; i < num_loops; i++) {
+        close(loops[i].epfd);
+    }
+    free(loops);
+    return 0;
+}
+
+/* ============================================================
+ * Sharded acceptor mode (--sharded N [--pin-shards])
+ *
+ * With one listen socket, accept() itself serializes connection setup
+ * under connect storms. In sharded mode every shard thread binds its own
+ * SO_REUSEPORT listen socket on the same port (the kernel hashes
+ * incoming connections across the sockets), runs its own event loop, and
+ * owns the connections it accepts end-to-end - no cross-core handoff of
+ * client fds. Shards reuse the epoll engine with num_loops=1 so the
+ * accept burst lands connections in the shard's own loop. Optionally
+ * each shard is pinned to CPU (shard index mod online CPUs).
+ * ============================================================ */
+
+struct shard_arg {
+    struct epoll_loop loop;
+    int pin_cpu;              /* -1 = unpinned */
+};
+
+static inline void *shard_run(void *arg) {
+    struct shard_arg *shard = (struct shard_arg *)arg;
+
+    if (shard->pin_cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(shard->pin_cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            perror("pthread_setaffinity_np");
+        }
+    }
+
+    return epoll_loop_run(&shard->loop);
+}
+
+/*
+ * Run num_shards acceptor shards on 'port'. Blocks until *running drops.
+ * Returns 0, or -1 if no shard could be set up.
+ */
+static inline int run_sharded_server(int port, int msg_size, int num_shards,
+                                     int pin_shards, epoll_send_fn send_fn,
+                                     volatile int *running) {
+    struct shard_arg *shards =
+        (struct shard_arg *)calloc((size_t)num_shards, sizeof(*shards));
+    if (!shards) return -1;
+
+    int ncpus = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpus < 1) ncpus = 1;
+
+    for (int i = 0; i < num_shards; i++) {
+        struct epoll_loop *loop = &shards[i].loop;
+
+        /* Every shard binds its own SO_REUSEPORT socket on the port */
+        int listen_fd = create_server_socket(port);
+        if (listen_fd < 0) {
+            free(shards);
+            return -1;
+        }
+        set_nonblocking(listen_fd);
+
+        loop->epfd = epoll_create1(0);
+        if (loop->epfd < 0) {
+            perror("epoll_create1");
+            close(listen_fd);
+            free(shards);
+            return -1;
+        }
+        loop->listen_fd = listen_fd;
+        pthread_mutex_init(&loop->conns_lock, NULL);
+        loop->msg_size = msg_size;
+        loop->field_size = msg_size / NUM_FIELDS;
+        loop->send_fn = send_fn;
+        loop->running = running;
+        /* num_loops=1 pointing at itself: accepted fds stay in-shard */
+        loop->loops = loop;
+        loop->num_loops = 1;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.ptr = NULL;
+        if (epoll_ctl(loop->epfd, EPOLL_CTL_ADD, listen_fd, &ev) != 0) {
+            perror("epoll_ctl add shard listen");
+            close(listen_fd);
+            close(loop->epfd);
+            free(shards);
+            return -1;
+        }
+
+        shards[i].pin_cpu = pin_shards ? (i % ncpus) : -1;
+    }
+
+    fprintf(stderr, "[sharded] %d SO_REUSEPORT acceptor shard(s)%s\n",
+            num_shards, pin_shards ? ", pinned" : "");
+
+    pthread_t *tids =
+        (pthread_t *)malloc(sizeof(pthread_t) * (size_t)(num_shards - 1));
+    for (int i = 1; i < num_shards; i++) {
+        pthread_create(&tids[i - 1], NULL, shard_run, &shards[i]);
+    }
+    shard_run(&shards[0]);  /* main thread drives shard 0 */
+
+    for (int i = 1; i < num_shards; i++) {
+        pthread_join(tids[i - 1], NULL);
+    }
+    free(tids);
+    for (int i = 0; i < num_shards; i++) {
+        close(shards[i].loop.listen_fd);
+        close(shards[i].loop.epfd);
+    }
+    free(shards);
+    return 0;
+}
+
+/* ============================================================
+ * Multi-connection epoll client (--conns N [--rate R])
+ *
+ * One blocking socket per thread caps load generation at the thread
+ * count - the generator dies before a 10k-connection server does. In
+ * multi-connection mode each client thread drives mc_conns non-blocking
+ * connections off one epoll instance, draining whichever are readable.
+ * An optional per-connection rate cap (messages/sec) stops reading a
+ * connection once its second's allowance is spent - TCP backpressure
+ * then paces the server - with allowances refilled on a 100 ms tick.
+ * Bytes aggregate into the thread's client_thread_args fields; message
+ * counts derive from bytes, and per-message latency is not meaningful
+ * when hundreds of streams interleave, so the histogram records per
+ * epoll-drain dwell instead.
+ * ============================================================ */
+
+struct mc_conn {
+    int       fd;
+    int       readable_armed;    /* registered for EPOLLIN right now */
+    long long bytes;
+    long long allowance;         /* bytes this connection may still read */
+};
+
+static inline void client_multi_conn_run(struct client_thread_args *cta) {
+    int num_conns = cta->mc_conns;
+    int msg_size = cta->msg_size;
+    long long rate_bytes = cta->mc_rate > 0
+                               ? (long long)cta->mc_rate * msg_size : 0;
+
+    struct mc_conn *conns =
+        (struct mc_conn *)calloc((size_t)num_conns, sizeof(*conns));
+    char *scratch = (char *)malloc(64 * 1024);
+    int epfd = epoll_create1(0);
+    if (!conns || !scratch || epfd < 0) {
+        perror("multi-conn setup");
+        free(conns);
+        free(scratch);
+        if (epfd >= 0) close(epfd);
+        return;
+    }
+
+    int established = 0;
+    for (int i = 0; i < num_conns; i++) {
+        conns[i].fd = connect_to_server(cta->server_ip, cta->port);
+        if (conns[i].fd < 0) {
+            break;  /* listen backlog or fd limit: run with what we got */
+        }
+        set_nonblocking(conns[i].fd);
+        conns[i].allowance = rate_bytes > 0 ? rate_bytes : 0;
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.u32 = (unsigned)i;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, conns[i].fd, &ev) != 0) {
+            close(conns[i].fd);
+            conns[i].fd = -1;
+            break;
+        }
+        conns[i].readable_armed = 1;
+        established++;
+    }
+    fprintf(stderr, "  Thread %d: %d/%d connections established%s\n",
+            cta->thread_id, established, num_conns,
+            rate_bytes > 0 ? " (rate-capped)" : "");
+
+    double start_time = get_time_us();
+    double end_time = start_time + (double)cta->duration * 1e6;
+    double last_refill = start_time;
+    long long total_bytes = 0;
+
+    struct epoll_event events[64];
+    while (get_time_us() < end_time) {
+        double wait_start = get_time_us();
+        int n = epoll_wait(epfd, events, 64, 100);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        lat_hist_record(&cta->hist, get_time_us() - wait_start);
+
+        for (int e = 0; e < n; e++) {
+            struct mc_conn *c = &conns[events[e].data.u32];
+            if (c->fd < 0) continue;
+
+            /* Drain until EAGAIN or the rate allowance runs dry */
+            for (;;) {
+                ssize_t got = recv(c->fd, scratch, 64 * 1024, 0);
+                if (got > 0) {
+                    c->bytes += got;
+                    total_bytes += got;
+                    if (rate_bytes > 0) {
+                        c->allowance -= got;
+                        if (c->allowance <= 0) {
+                            /* Spent: stop reading; backpressure paces the
+                             * server until the next refill re-arms us */
+                            struct epoll_event ev;
+                            memset(&ev, 0, sizeof(ev));
+                            ev.data.u32 = events[e].data.u32;
+                            ev.events = 0;
+                            epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+                            c->readable_armed = 0;
+                            break;
+                        }
+                    }
+                    continue;
+                }
+                if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                }
+                /* Peer closed or errored */
+                epoll_ctl(epfd, EPOLL_CTL_DEL, c->fd, NULL);
+                close(c->fd);
+                c->fd = -1;
+                break;
+            }
+        }
+
+        /* Refill rate allowances once per second of accumulated time */
+        double now = get_time_us();
+        if (rate_bytes > 0 && now - last_refill >= 1e6) {
+            last_refill = now;
+            for (int i = 0; i < num_conns; i++) {
+                if (conns[i].fd < 0) continue;
+                conns[i].allowance = rate_bytes;
+                if (!conns[i].readable_armed) {
+                    struct epoll_event ev;
+                    memset(&ev, 0, sizeof(ev));
+                    ev.data.u32 = (unsigned)i;
+                    ev.events = EPOLLIN;
+                    epoll_ctl(epfd, EPOLL_CTL_MOD, conns[i].fd, &ev);
+                    conns[i].readable_armed = 1;
+                }
+            }
+        }
+    }
+
+    double elapsed_s = (get_time_us() - start_time) / 1e6;
+
+    cta->bytes_received = total_bytes;
+    cta->messages_received = total_bytes / msg_size;
+    cta->total_latency_us = 0.0;
+
+    fprintf(stderr, "  Thread %d: %d conns, %.2f MB, %.4f Gbps\n",
+            cta->thread_id, established,
+            total_bytes / (1024.0 * 1024.0),
+            (total_bytes * 8.0) / (elapsed_s * 1e9));
+
+    for (int i = 0; i < num_conns; i++) {
+        if (conns[i].fd >= 0) {
+            close(conns[i].fd);
+        }
+    }
+    close(epfd);
+    free(scratch);
+    free(conns);
+}
+
+/* ============================================================
+ * Lock-free per-connection server statistics
+ *
+ * The servers used to run blind: counters lived in handler locals and
+ * died with the connection. Each connection now owns a cache-line-padded
+ * slot of atomics (messages, bytes, ENOBUFS/EAGAIN events, and a coarse
+ * send-call latency histogram); writers touch only their own line, and a
+ * reporter thread aggregates across slots lock-free for a periodic
+ * one-line dump. SIGUSR1 forces an immediate snapshot, so an anomalous
+ * run can be diagnosed from the artifact instead of a strace rerun.
+ * ============================================================ */
+
+#define SRV_STATS_SLOTS       256
+#define SRV_STATS_LAT_BUCKETS 4   /* <10us, <100us, <1ms, >=1ms */
+
+struct srv_conn_stats {
+    _Atomic long long msgs;
+    _Atomic long long bytes;
+    _Atomic long long enobufs;
+    _Atomic long long eagain;
+    _Atomic long long lat[SRV_STATS_LAT_BUCKETS];
+    _Atomic int       in_use;
+} __attribute__((aligned(64)));
+
+static struct srv_conn_stats g_srv_stats[SRV_STATS_SLOTS];
+
+/* Retired-connections accumulator: slots fold their counters in here on
+ * release, so the periodic dump stays cumulative and monotonic across
+ * connection churn instead of losing history when a slot is reused */
+static struct srv_conn_stats g_srv_stats_retired;
+
+static volatile sig_atomic_t g_srv_stats_dump_requested;
+static const char *g_srv_stats_tag = "server";
+
+/* Claim a free slot (NULL when all are taken; stats are then dropped) */
+static inline struct srv_conn_stats *srv_stats_acquire(void) {
+    for (int i = 0; i < SRV_STATS_SLOTS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&g_srv_stats[i].in_use,
+                                           &expected, 1)) {
+            atomic_store(&g_srv_stats[i].msgs, 0);
+            atomic_store(&g_srv_stats[i].bytes, 0);
+            atomic_store(&g_srv_stats[i].enobufs, 0);
+            atomic_store(&g_srv_stats[i].eagain, 0);
+            for (int b = 0; b < SRV_STATS_LAT_BUCKETS; b++) {
+                atomic_store(&g_srv_stats[i].lat[b], 0);
+            }
+            return &g_srv_stats[i];
+        }
+    }
+    return NULL;
+}
+
+static inline void srv_stats_release(struct srv_conn_stats *st) {
+    if (!st) return;
+
+    /* Fold this connection's history into the retired totals, then zero
+     * the slot so its next owner starts clean */
+    atomic_fetch_add(&g_srv_stats_retired.msgs, atomic_load(&st->msgs));
+    atomic_fetch_add(&g_srv_stats_retired.bytes, atomic_load(&st->bytes));
+    atomic_fetch_add(&g_srv_stats_retired.enobufs, atomic_load(&st->enobufs));
+    atomic_fetch_add(&g_srv_stats_retired.eagain, atomic_load(&st->eagain));
+    for (int b = 0; b < SRV_STATS_LAT_BUCKETS; b++) {
+        atomic_fetch_add(&g_srv_stats_retired.lat[b],
+                         atomic_load(&st->lat[b]));
+    }
+    atomic_store(&st->msgs, 0);
+    atomic_store(&st->bytes, 0);
+    atomic_store(&st->enobufs, 0);
+    atomic_store(&st->eagain, 0);
+    for (int b = 0; b < SRV_STATS_LAT_BUCKETS; b++) {
+        atomic_store(&st->lat[b], 0);
+    }
+    atomic_store(&st->in_use, 0);
+}
+
+/* One successful send of 'bytes' that took 'latency_us' in the call */
+static inline void srv_stats_record(struct srv_conn_stats *st,
+                                    long long bytes, double latency_us) {
+    if (!st) return;
+    atomic_fetch_add_explicit(&st->msgs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&st->bytes, bytes, memory_order_relaxed);
+    int b = latency_us < 10.0 ? 0
+          : latency_us < 100.0 ? 1
+          : latency_us < 1000.0 ? 2 : 3;
+    atomic_fetch_add_explicit(&st->lat[b], 1, memory_order_relaxed);
+}
+
+static inline void srv_stats_record_err(struct srv_conn_stats *st, int err) {
+    if (!st) return;
+    if (err == ENOBUFS) {
+        atomic_fetch_add_explicit(&st->enobufs, 1, memory_order_relaxed);
+    } else if (err == EAGAIN || err == EWOULDBLOCK) {
+        atomic_fetch_add_explicit(&st->eagain, 1, memory_order_relaxed);
+    }
+}
+
+/* Aggregate all slots and print the one-line snapshot */
+static inline void srv_stats_dump(void) {
+    /* Cumulative: retired history plus every live slot */
+    long long msgs    = atomic_load(&g_srv_stats_retired.msgs);
+    long long bytes   = atomic_load(&g_srv_stats_retired.bytes);
+    long long enobufs = atomic_load(&g_srv_stats_retired.enobufs);
+    long long eagain  = atomic_load(&g_srv_stats_retired.eagain);
+    long long lat[SRV_STATS_LAT_BUCKETS];
+    for (int b = 0; b < SRV_STATS_LAT_BUCKETS; b++) {
+        lat[b] = atomic_load(&g_srv_stats_retired.lat[b]);
+    }
+    int conns = 0;
+
+    for (int i = 0; i < SRV_STATS_SLOTS; i++) {
+        if (atomic_load_explicit(&g_srv_stats[i].in_use,
+                                 memory_order_relaxed)) {
+            conns++;
+        }
+        msgs    += atomic_load_explicit(&g_srv_stats[i].msgs, memory_order_relaxed);
+        bytes   += atomic_load_explicit(&g_srv_stats[i].bytes, memory_order_relaxed);
+        enobufs += atomic_load_explicit(&g_srv_stats[i].enobufs, memory_order_relaxed);
+        eagain  += atomic_load_explicit(&g_srv_stats[i].eagain, memory_order_relaxed);
+        for (int b = 0; b < SRV_STATS_LAT_BUCKETS; b++) {
+            lat[b] += atomic_load_explicit(&g_srv_stats[i].lat[b],
+                                           memory_order_relaxed);
+        }
+    }
+
+    fprintf(stderr, "[%s stats] conns=%d msgs=%lld bytes=%.1fMB "
+            "enobufs=%lld eagain=%lld "
+            "send_lat[<10us/<100us/<1ms/>=1ms]=%lld/%lld/%lld/%lld\n",
+            g_srv_stats_tag, conns, msgs, bytes / (1024.0 * 1024.0),
+            enobufs, eagain, lat[0], lat[1], lat[2], lat[3]);
+}
+
+static inline void srv_stats_sigusr1_handler(int sig) {
+    (void)sig;
+    g_srv_stats_dump_requested = 1;
+}
+
+/* Reporter thread: periodic dump plus SIGUSR1-triggered snapshots */
+static inline void *srv_stats_reporter(void *arg) {
+    int interval_s = (int)(long)arg;
+    int elapsed = 0;
+    for (;;) {
+        sleep(1);
+        elapsed++;
+        if (g_srv_stats_dump_requested || elapsed >= interval_s) {
+            g_srv_stats_dump_requested = 0;
+            elapsed = 0;
+            srv_stats_dump();
+        }
+    }
+    return NULL;
+}
+
+/* Install SIGUSR1 and start the periodic reporter (call once from main) */
+static inline void srv_stats_start(const char *tag, int interval_s) {
+    g_srv_stats_tag = tag;
+    install_signal_handler(SIGUSR1, srv_stats_sigusr1_handler);
+
+    pthread_t tid;
+    if (pthread_create(&tid, NULL, srv_stats_reporter,
+                       (void *)(long)interval_s) == 0) {
+        pthread_detach(tid);
+    }
+}
+
 #endif /* MT25077_COMMON_H */
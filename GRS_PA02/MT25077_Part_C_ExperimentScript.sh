@@ -46,11 +46,19 @@ declare -A SERVER_BINS=(
     ["two_copy"]="a1_server"
     ["one_copy"]="a2_server"
     ["zero_copy"]="a3_server"
+    ["io_uring"]="a4_server"
+    ["sendfile"]="a5_server"
+    ["udp_gso"]="a6_server"
+    ["shm_ring"]="a7_server"
 )
 declare -A CLIENT_BINS=(
     ["two_copy"]="a1_client"
     ["one_copy"]="a2_client"
     ["zero_copy"]="a3_client"
+    ["io_uring"]="a4_client"
+    ["sendfile"]="a5_client"
+    ["udp_gso"]="a6_client"
+    ["shm_ring"]="a7_client"
 )
 
 # Output CSV file
@@ -68,7 +76,7 @@ cleanup() {
     echo "[INFO] Cleaning up..."
 
     # Kill any leftover server processes
-    ip netns exec "$NS_SERVER" killall -9 a1_server a2_server a3_server 2>/dev/null || true
+    ip netns exec "$NS_SERVER" killall -9 a1_server a2_server a3_server a4_server a5_server a6_server a7_server 2>/dev/null || true
 
     # Delete namespaces (also removes veth pairs)
     ip netns del "$NS_SERVER" 2>/dev/null || true
@@ -188,10 +196,10 @@ echo " Step 4: Running experiments"
 echo "============================================================"
 
 # Write CSV header
-echo "implementation,msg_size,thread_count,throughput_gbps,latency_us,total_bytes,total_msgs,cycles,l1_cache_misses,llc_cache_misses,context_switches" \
+echo "implementation,msg_size,thread_count,throughput_gbps,latency_us,total_bytes,total_msgs,p50_us,p90_us,p99_us,p999_us,max_us,cycles,l1_cache_misses,llc_cache_misses,context_switches" \
     > "$CSV_FILE"
 
-IMPLEMENTATIONS=(two_copy one_copy zero_copy)
+IMPLEMENTATIONS=(two_copy one_copy zero_copy io_uring sendfile udp_gso shm_ring)
 TOTAL_EXPS=$(( ${#IMPLEMENTATIONS[@]} * ${#MSG_SIZES[@]} * ${#THREAD_COUNTS[@]} ))
 EXP_NUM=0
 FAILED=0
@@ -200,6 +208,24 @@ for IMPL in "${IMPLEMENTATIONS[@]}"; do
     for MSG_SIZE in "${MSG_SIZES[@]}"; do
         for THREADS in "${THREAD_COUNTS[@]}"; do
             EXP_NUM=$((EXP_NUM + 1))
+
+            # UDP datagrams cap at 65507 payload bytes; a6_server rejects
+            # larger sizes at startup, so the cell can never produce data
+            if [[ "$IMPL" == "udp_gso" && "$MSG_SIZE" -gt 65507 ]]; then
+                echo ""
+                echo "--- Experiment ${EXP_NUM}/${TOTAL_EXPS}: ${IMPL} | msg_size=${MSG_SIZE} [SKIP: exceeds UDP payload cap] ---"
+                continue
+            fi
+
+            # The shm ring is strictly single-consumer: the client forces
+            # thread_count to 1, so higher cells would just relabel the
+            # same measurement
+            if [[ "$IMPL" == "shm_ring" && "$THREADS" -gt 1 ]]; then
+                echo ""
+                echo "--- Experiment ${EXP_NUM}/${TOTAL_EXPS}: ${IMPL} | threads=${THREADS} [SKIP: SPSC, covered by threads=1] ---"
+                continue
+            fi
+
             echo ""
             echo "--- Experiment ${EXP_NUM}/${TOTAL_EXPS}: ${IMPL} | msg_size=${MSG_SIZE} | threads=${THREADS} ---"
 
@@ -240,7 +266,7 @@ for IMPL in "${IMPLEMENTATIONS[@]}"; do
             sleep 1  # Let port release
 
             # ---- Parse client output ----
-            # Expected format: RESULT,<impl>,<msg_size>,<threads>,<throughput>,<latency>,<bytes>,<msgs>
+            # Expected format: RESULT,<impl>,<msg_size>,<threads>,<throughput>,<latency>,<bytes>,<msgs>,<p50>,<p90>,<p99>,<p99.9>,<max>
             RESULT_LINE=$(grep "^RESULT," "$CLIENT_OUT" 2>/dev/null || echo "")
 
             if [[ -z "$RESULT_LINE" ]]; then
@@ -255,6 +281,16 @@ for IMPL in "${IMPLEMENTATIONS[@]}"; do
             LATENCY=$(echo "$RESULT_LINE" | cut -d',' -f6)
             TOTAL_BYTES=$(echo "$RESULT_LINE" | cut -d',' -f7)
             TOTAL_MSGS=$(echo "$RESULT_LINE" | cut -d',' -f8)
+            P50=$(echo "$RESULT_LINE" | cut -d',' -f9)
+            P90=$(echo "$RESULT_LINE" | cut -d',' -f10)
+            P99=$(echo "$RESULT_LINE" | cut -d',' -f11)
+            P999=$(echo "$RESULT_LINE" | cut -d',' -f12)
+            PMAX=$(echo "$RESULT_LINE" | cut -d',' -f13)
+            [[ -z "$P50" ]]  && P50=0
+            [[ -z "$P90" ]]  && P90=0
+            [[ -z "$P99" ]]  && P99=0
+            [[ -z "$P999" ]] && P999=0
+            [[ -z "$PMAX" ]] && PMAX=0
 
             # ---- Parse perf stat output ----
             # Extract numeric values from perf stat. Use subshell to avoid pipefail issues.
@@ -270,10 +306,10 @@ for IMPL in "${IMPLEMENTATIONS[@]}"; do
             [[ -z "$CTX_SW" ]]     && CTX_SW=0
 
             # ---- Append to CSV ----
-            echo "${IMPL},${MSG_SIZE},${THREADS},${THROUGHPUT},${LATENCY},${TOTAL_BYTES},${TOTAL_MSGS},${CYCLES},${L1_MISSES},${LLC_MISSES},${CTX_SW}" \
+            echo "${IMPL},${MSG_SIZE},${THREADS},${THROUGHPUT},${LATENCY},${TOTAL_BYTES},${TOTAL_MSGS},${P50},${P90},${P99},${P999},${PMAX},${CYCLES},${L1_MISSES},${LLC_MISSES},${CTX_SW}" \
                 >> "$CSV_FILE"
 
-            echo "  Throughput=${THROUGHPUT} Gbps, Latency=${LATENCY} us"
+            echo "  Throughput=${THROUGHPUT} Gbps, Latency=${LATENCY} us (p50=${P50} p99=${P99} p99.9=${P999})"
             echo "  Cycles=${CYCLES}, L1_misses=${L1_MISSES}, LLC_misses=${LLC_MISSES}, ctx_sw=${CTX_SW}"
         done
     done